@@ -19,7 +19,12 @@ signal generation_started(request_id: int)
 signal generation_completed(request_id: int, audio: AudioStreamWAV)
 signal generation_failed(request_id: int, error: String)
 signal chunk_ready(request_id: int, chunk_index: int, total_chunks: int, audio: AudioStreamWAV)
+## Emitted after the last chunk of a speak_streaming() or begin_stream() stream.
+## If that chunk fails, generation_failed is emitted instead and the stream
+## never completes.
 signal stream_completed(request_id: int)
+signal render_progress(request_id: int, chunks_done: int, total_chunks: int)
+signal render_completed(request_id: int, path: String)
 
 ## Path to the Kokoro model files
 @export_group("Model")
@@ -69,6 +74,14 @@ signal stream_completed(request_id: int)
 		if _tts:
 			_tts.debug_mode = value
 
+## Record per-stage timing spans (queue wait, inference, delivery...) for
+## export_trace(). Cheap enough to leave on in playtest builds.
+@export var trace_enabled: bool = false:
+	set(value):
+		trace_enabled = value
+		if _tts:
+			_tts.trace_enabled = value
+
 ## Max sentences per batch (higher = better for long text, lower = lower latency)
 @export_range(1, 10, 1) var max_sentences: int = 2:
 	set(value):
@@ -76,6 +89,82 @@ signal stream_completed(request_id: int)
 		if _tts:
 			_tts.max_sentences = value
 
+## Worker threads, each with its own engine, so chunks of one stream are
+## synthesized concurrently (memory grows per engine). Applied at initialize().
+@export_range(1, 8, 1) var parallel_workers: int = 1:
+	set(value):
+		parallel_workers = value
+		if _tts:
+			_tts.parallel_workers = value
+
+## Seconds of audio a stream may be synthesized ahead of playback (0 = unlimited)
+@export_range(0, 120, 0.5, "suffix:s") var stream_lookahead: float = 10.0:
+	set(value):
+		stream_lookahead = value
+		if _tts:
+			_tts.stream_lookahead = value
+
+## Run synthesis as low-priority WorkerThreadPool tasks instead of dedicated
+## threads; auto thread count then leaves half the pool to the game. Applied at initialize().
+@export var use_worker_thread_pool: bool = false:
+	set(value):
+		use_worker_thread_pool = value
+		if _tts:
+			_tts.use_worker_thread_pool = value
+
+## speak_streaming() starts with a single clause, then merges sentences into
+## larger chunks based on the synthesis speed measured on this machine
+@export var adaptive_chunking: bool = false:
+	set(value):
+		adaptive_chunking = value
+		if _tts:
+			_tts.adaptive_chunking = value
+
+## Seconds of buffered audio adaptive chunking keeps ahead of playback
+@export_range(0, 10, 0.1, "suffix:s") var adaptive_chunk_margin: float = 0.5:
+	set(value):
+		adaptive_chunk_margin = value
+		if _tts:
+			_tts.adaptive_chunk_margin = value
+
+## Share one synthesis between identical speak_async() calls that overlap
+@export var coalesce_requests: bool = true:
+	set(value):
+		coalesce_requests = value
+		if _tts:
+			_tts.coalesce_requests = value
+
+## Release the engine after this many idle seconds (0 = keep loaded).
+## The next request reloads it transparently from the same model files.
+@export_range(0, 3600, 1, "or_greater", "suffix:s") var idle_unload_timeout: float = 0.0:
+	set(value):
+		idle_unload_timeout = value
+		if _tts:
+			_tts.idle_unload_timeout = value
+
+## Synthesis backend. Mock produces deterministic tones without model files,
+## for testing and benchmarking game code. Applied at initialize().
+@export_group("Backend")
+@export var backend: TextToSpeech.Backend = TextToSpeech.BACKEND_SHERPA:
+	set(value):
+		backend = value
+		if _tts:
+			_tts.backend = value
+
+## Mock backend: fixed seconds each synthesis call takes
+@export_range(0, 5, 0.001, "suffix:s") var mock_latency: float = 0.0:
+	set(value):
+		mock_latency = value
+		if _tts:
+			_tts.mock_latency = value
+
+## Mock backend: extra seconds per second of audio (0.2 = five times real time)
+@export_range(0, 2, 0.01) var mock_real_time_factor: float = 0.0:
+	set(value):
+		mock_real_time_factor = value
+		if _tts:
+			_tts.mock_real_time_factor = value
+
 ## Streaming Settings
 @export_group("Streaming")
 
@@ -103,7 +192,18 @@ func _ready():
 	# Apply performance settings before model loads
 	_tts.num_threads = num_threads
 	_tts.debug_mode = debug_mode
+	_tts.trace_enabled = trace_enabled
 	_tts.max_sentences = max_sentences
+	_tts.parallel_workers = parallel_workers
+	_tts.stream_lookahead = stream_lookahead
+	_tts.use_worker_thread_pool = use_worker_thread_pool
+	_tts.adaptive_chunking = adaptive_chunking
+	_tts.adaptive_chunk_margin = adaptive_chunk_margin
+	_tts.coalesce_requests = coalesce_requests
+	_tts.idle_unload_timeout = idle_unload_timeout
+	_tts.backend = backend
+	_tts.mock_latency = mock_latency
+	_tts.mock_real_time_factor = mock_real_time_factor
 
 	# Connect signals
 	_tts.model_loaded.connect(_on_model_loaded)
@@ -113,6 +213,8 @@ func _ready():
 	_tts.generation_failed.connect(_on_generation_failed)
 	_tts.chunk_ready.connect(_on_chunk_ready)
 	_tts.stream_completed.connect(_on_stream_completed)
+	_tts.render_progress.connect(_on_render_progress)
+	_tts.render_completed.connect(_on_render_completed)
 
 ## Initialize the TTS engine with the configured model
 func initialize() -> bool:
@@ -120,6 +222,12 @@ func initialize() -> bool:
 		print("KokoroTTS ERROR: TextToSpeech node not created")
 		return false
 
+	if backend == TextToSpeech.BACKEND_MOCK:
+		_tts.load_model("", "", "")
+		_tts.speaker_id = speaker_id
+		_tts.speed = speed
+		return _tts.is_model_loaded()
+
 	# Check if files exist (with debug output)
 	var model_exists = FileAccess.file_exists(model_path)
 	var voices_exists = FileAccess.file_exists(voices_path)
@@ -199,6 +307,12 @@ func _on_stream_completed(request_id: int):
 	_is_streaming = false
 	stream_completed.emit(request_id)
 
+func _on_render_progress(request_id: int, chunks_done: int, total_chunks: int):
+	render_progress.emit(request_id, chunks_done, total_chunks)
+
+func _on_render_completed(request_id: int, path: String):
+	render_completed.emit(request_id, path)
+
 ## Async speech generation (non-blocking) - returns request ID
 func speak_async(text: String) -> int:
 	if not is_ready():
@@ -226,6 +340,46 @@ func speak_streaming(text: String) -> int:
 	_current_stream_id = _tts.speak_streaming(full_text)
 	return _current_stream_id
 
+## Incremental streaming for text that arrives piece by piece (e.g. LLM tokens).
+## Each sentence is synthesized as soon as it is complete; chunk_ready reports
+## total_chunks = -1 until end_stream() fixes the count, and stream_completed fires
+## after end_stream() (unless the last chunk failed, as with speak_streaming()).
+func begin_stream() -> int:
+	if not is_ready():
+		push_error("KokoroTTS: Model not loaded")
+		return 0
+	_audio_queue.clear()
+	_is_streaming = true
+	_current_stream_id = _tts.begin_stream()
+	return _current_stream_id
+
+## Append text to a stream opened with begin_stream()
+func feed_text(stream_id: int, fragment: String) -> bool:
+	if not _tts:
+		return false
+	return _tts.feed_text(stream_id, fragment)
+
+## Close a stream; any trailing text without punctuation becomes the last chunk
+func end_stream(stream_id: int) -> bool:
+	if not _tts:
+		return false
+	return _tts.end_stream(stream_id)
+
+## Render long text to a WAV file in the background (e.g. "user://chapter1.wav").
+## Memory use stays flat regardless of length; render_progress fires per chunk
+## and render_completed once the file is written. Only "wav" is supported.
+func render_to_file(text: String, path: String, format: String = "wav") -> int:
+	if not is_ready():
+		push_error("KokoroTTS: Model not loaded")
+		return 0
+	return _tts.render_to_file(text, path, format)
+
+## Stop a render after its current chunk; the partial file is deleted
+func cancel_render(request_id: int) -> bool:
+	if not _tts:
+		return false
+	return _tts.cancel_render(request_id)
+
 ## Check if currently streaming
 func is_streaming() -> bool:
 	return _is_streaming
@@ -241,6 +395,20 @@ func cancel() -> void:
 	if _tts:
 		_tts.cancel_generation()
 
+## Get memory usage in bytes: {"model", "queue", "cached_audio", "total"}.
+## "model" is the on-disk size of the model files, data_dir and dict_dir
+## per resident engine.
+func get_memory_usage() -> Dictionary:
+	if not _tts:
+		return {}
+	return _tts.get_memory_usage()
+
+## Write the recorded trace as Chrome trace JSON; open it in ui.perfetto.dev
+func export_trace(path: String = "user://tts_trace.json") -> bool:
+	if not _tts:
+		return false
+	return _tts.export_trace(path)
+
 ## Get the optimal thread count for this system
 func get_optimal_thread_count() -> int:
 	if _tts:
@@ -0,0 +1,62 @@
+#include "mock_backend.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace godot;
+
+// Roughly the pace of Kokoro speech at speed 1.0
+static const float SECONDS_PER_CHARACTER = 0.06f;
+
+MockBackend::MockBackend(float p_latency, float p_real_time_factor) :
+        latency(p_latency),
+        real_time_factor(p_real_time_factor) {
+}
+
+bool MockBackend::create(const TTSBackendConfig &) {
+    created = true;
+    return true;
+}
+
+bool MockBackend::generate(const String &text, int speaker_id, float speed, const TTSAudioSink &sink) {
+    if (!created || text.is_empty() || speed <= 0.0f) {
+        return false;
+    }
+
+    float duration = text.length() * SECONDS_PER_CHARACTER / speed;
+    int32_t count = static_cast<int32_t>(duration * SAMPLE_RATE);
+    if (count <= 0) {
+        return false;
+    }
+
+    // Simulate inference time before producing anything
+    float delay = latency + real_time_factor * duration;
+    if (delay > 0.0f) {
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(delay * 1000000.0f)));
+    }
+
+    // One tone per character, pitch chosen by character and speaker, so
+    // output depends only on the inputs
+    const float two_pi = 6.28318530718f;
+    int32_t samples_per_char = count / static_cast<int32_t>(text.length());
+    if (samples_per_char <= 0) samples_per_char = 1;
+    samples.resize(count);
+    for (int32_t i = 0; i < count; i++) {
+        int64_t char_index = std::min<int64_t>(i / samples_per_char, text.length() - 1);
+        float frequency = 110.0f + 20.0f * (speaker_id % SPEAKER_COUNT) + 5.0f * (text[char_index] % 64);
+        samples[i] = 0.3f * std::sin(two_pi * frequency * i / SAMPLE_RATE);
+    }
+
+    sink(samples.data(), count, SAMPLE_RATE);
+    return true;
+}
+
+int MockBackend::get_sample_rate() const {
+    return created ? SAMPLE_RATE : 0;
+}
+
+int MockBackend::get_speaker_count() const {
+    return created ? SPEAKER_COUNT : 0;
+}
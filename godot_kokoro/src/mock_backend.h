@@ -0,0 +1,34 @@
+#ifndef MOCK_BACKEND_H
+#define MOCK_BACKEND_H
+
+#include "tts_backend.h"
+
+#include <vector>
+
+namespace godot {
+
+// Deterministic stand-in for benchmarking and testing the scheduling, queue
+// and signal logic without a model. The same text/speaker/speed always yields
+// the same samples, and each call takes latency + real_time_factor * duration.
+class MockBackend : public TTSBackend {
+private:
+    float latency;            // Fixed seconds per generate() call
+    float real_time_factor;   // Extra seconds per second of generated audio
+    bool created = false;
+    std::vector<float> samples;
+
+public:
+    static const int SAMPLE_RATE = 24000;
+    static const int SPEAKER_COUNT = 8;
+
+    MockBackend(float p_latency, float p_real_time_factor);
+
+    bool create(const TTSBackendConfig &config) override;
+    bool generate(const String &text, int speaker_id, float speed, const TTSAudioSink &sink) override;
+    int get_sample_rate() const override;
+    int get_speaker_count() const override;
+};
+
+} // namespace godot
+
+#endif // MOCK_BACKEND_H
@@ -0,0 +1,93 @@
+#include "sherpa_backend.h"
+
+// Include sherpa-onnx C API
+#include "sherpa-onnx/c-api/c-api.h"
+
+#include <cstring>
+
+using namespace godot;
+
+SherpaBackend::~SherpaBackend() {
+    if (tts) {
+        SherpaOnnxDestroyOfflineTts(tts);
+        tts = nullptr;
+    }
+}
+
+bool SherpaBackend::create(const TTSBackendConfig &config) {
+    if (tts) {
+        SherpaOnnxDestroyOfflineTts(tts);
+        tts = nullptr;
+    }
+
+    // Convert to UTF8 - must keep these alive until after API call
+    CharString model_utf8 = config.model_path.utf8();
+    CharString voices_utf8 = config.voices_path.utf8();
+    CharString tokens_utf8 = config.tokens_path.utf8();
+    CharString data_dir_utf8 = config.data_dir.utf8();
+    CharString lexicon_utf8 = config.lexicon_path.utf8();
+    CharString dict_utf8 = config.dict_dir.utf8();
+    CharString lang_utf8 = config.lang.utf8();
+
+    // Initialize config
+    SherpaOnnxOfflineTtsConfig tts_config;
+    memset(&tts_config, 0, sizeof(tts_config));
+
+    // Set Kokoro model config
+    tts_config.model.kokoro.model = model_utf8.get_data();
+    tts_config.model.kokoro.voices = voices_utf8.get_data();
+    tts_config.model.kokoro.tokens = tokens_utf8.get_data();
+    tts_config.model.kokoro.data_dir = data_dir_utf8.get_data();
+    tts_config.model.kokoro.length_scale = 1.0f;
+    tts_config.model.kokoro.dict_dir = dict_utf8.get_data();
+    tts_config.model.kokoro.lexicon = lexicon_utf8.get_data();
+    tts_config.model.kokoro.lang = lang_utf8.get_data();
+
+    // General model config
+    tts_config.model.num_threads = config.num_threads;
+    tts_config.model.debug = config.debug ? 1 : 0;
+    tts_config.model.provider = "cpu";
+
+    // TTS config
+    tts_config.max_num_sentences = config.max_sentences;
+
+    // Create TTS engine
+    tts = SherpaOnnxCreateOfflineTts(&tts_config);
+    return tts != nullptr;
+}
+
+bool SherpaBackend::generate(const String &text, int speaker_id, float speed, const TTSAudioSink &sink) {
+    if (!tts) {
+        return false;
+    }
+
+    // Keep text UTF8 alive during API call
+    CharString text_utf8 = text.utf8();
+
+    // Generate audio
+    const SherpaOnnxGeneratedAudio *audio =
+        SherpaOnnxOfflineTtsGenerate(tts, text_utf8.get_data(), speaker_id, speed);
+
+    if (!audio || audio->n <= 0) {
+        if (audio) {
+            SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
+        }
+        return false;
+    }
+
+    sink(audio->samples, audio->n, audio->sample_rate);
+
+    // Cleanup sherpa audio
+    SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
+    return true;
+}
+
+int SherpaBackend::get_sample_rate() const {
+    if (!tts) return 0;
+    return SherpaOnnxOfflineTtsSampleRate(tts);
+}
+
+int SherpaBackend::get_speaker_count() const {
+    if (!tts) return 0;
+    return SherpaOnnxOfflineTtsNumSpeakers(tts);
+}
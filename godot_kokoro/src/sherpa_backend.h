@@ -0,0 +1,27 @@
+#ifndef SHERPA_BACKEND_H
+#define SHERPA_BACKEND_H
+
+#include "tts_backend.h"
+
+// Forward declaration - sherpa-onnx C API types
+typedef struct SherpaOnnxOfflineTts SherpaOnnxOfflineTts;
+
+namespace godot {
+
+// Default backend: Kokoro via the sherpa-onnx C API
+class SherpaBackend : public TTSBackend {
+private:
+    const SherpaOnnxOfflineTts *tts = nullptr;
+
+public:
+    ~SherpaBackend() override;
+
+    bool create(const TTSBackendConfig &config) override;
+    bool generate(const String &text, int speaker_id, float speed, const TTSAudioSink &sink) override;
+    int get_sample_rate() const override;
+    int get_speaker_count() const override;
+};
+
+} // namespace godot
+
+#endif // SHERPA_BACKEND_H
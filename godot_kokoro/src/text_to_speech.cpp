@@ -3,13 +3,18 @@
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
 #include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
 
-// Include sherpa-onnx C API
-#include "sherpa-onnx/c-api/c-api.h"
+#include "sherpa_backend.h"
+#include "mock_backend.h"
 
 #include <cstring>
 #include <algorithm>
+#include <chrono>
 
 using namespace godot;
 
@@ -39,10 +44,17 @@ void TextToSpeech::_bind_methods() {
     ClassDB::bind_method(D_METHOD("speak_async", "text"), &TextToSpeech::speak_async);
     ClassDB::bind_method(D_METHOD("speak_streaming", "text"), &TextToSpeech::speak_streaming);
     ClassDB::bind_static_method("TextToSpeech", D_METHOD("split_into_chunks", "text"), &TextToSpeech::split_into_chunks);
+    ClassDB::bind_method(D_METHOD("render_to_file", "text", "path", "format"), &TextToSpeech::render_to_file, DEFVAL("wav"));
+    ClassDB::bind_method(D_METHOD("cancel_render", "request_id"), &TextToSpeech::cancel_render);
+    ClassDB::bind_method(D_METHOD("begin_stream"), &TextToSpeech::begin_stream);
+    ClassDB::bind_method(D_METHOD("feed_text", "stream_id", "fragment"), &TextToSpeech::feed_text);
+    ClassDB::bind_method(D_METHOD("end_stream", "stream_id"), &TextToSpeech::end_stream);
     ClassDB::bind_method(D_METHOD("is_generating"), &TextToSpeech::is_generating);
     ClassDB::bind_method(D_METHOD("cancel_generation"), &TextToSpeech::cancel_generation);
     ClassDB::bind_method(D_METHOD("get_speaker_count"), &TextToSpeech::get_speaker_count);
     ClassDB::bind_method(D_METHOD("get_sample_rate"), &TextToSpeech::get_sample_rate);
+    ClassDB::bind_method(D_METHOD("get_memory_usage"), &TextToSpeech::get_memory_usage);
+    ClassDB::bind_method(D_METHOD("is_engine_resident"), &TextToSpeech::is_engine_resident);
     ClassDB::bind_static_method("TextToSpeech", D_METHOD("get_optimal_thread_count"), &TextToSpeech::get_optimal_thread_count);
 
     // Property getters/setters - voice
@@ -56,8 +68,35 @@ void TextToSpeech::_bind_methods() {
     ClassDB::bind_method(D_METHOD("get_num_threads"), &TextToSpeech::get_num_threads);
     ClassDB::bind_method(D_METHOD("set_debug_mode", "enabled"), &TextToSpeech::set_debug_mode);
     ClassDB::bind_method(D_METHOD("get_debug_mode"), &TextToSpeech::get_debug_mode);
+    ClassDB::bind_method(D_METHOD("set_coalesce_requests", "enabled"), &TextToSpeech::set_coalesce_requests);
+    ClassDB::bind_method(D_METHOD("get_coalesce_requests"), &TextToSpeech::get_coalesce_requests);
+    ClassDB::bind_method(D_METHOD("set_parallel_workers", "count"), &TextToSpeech::set_parallel_workers);
+    ClassDB::bind_method(D_METHOD("get_parallel_workers"), &TextToSpeech::get_parallel_workers);
+    ClassDB::bind_method(D_METHOD("set_stream_lookahead", "seconds"), &TextToSpeech::set_stream_lookahead);
+    ClassDB::bind_method(D_METHOD("get_stream_lookahead"), &TextToSpeech::get_stream_lookahead);
+    ClassDB::bind_method(D_METHOD("set_use_worker_thread_pool", "enabled"), &TextToSpeech::set_use_worker_thread_pool);
+    ClassDB::bind_method(D_METHOD("get_use_worker_thread_pool"), &TextToSpeech::get_use_worker_thread_pool);
+    ClassDB::bind_method(D_METHOD("set_adaptive_chunking", "enabled"), &TextToSpeech::set_adaptive_chunking);
+    ClassDB::bind_method(D_METHOD("get_adaptive_chunking"), &TextToSpeech::get_adaptive_chunking);
+    ClassDB::bind_method(D_METHOD("set_adaptive_chunk_margin", "seconds"), &TextToSpeech::set_adaptive_chunk_margin);
+    ClassDB::bind_method(D_METHOD("get_adaptive_chunk_margin"), &TextToSpeech::get_adaptive_chunk_margin);
+    ClassDB::bind_method(D_METHOD("get_measured_real_time_factor"), &TextToSpeech::get_measured_real_time_factor);
+    ClassDB::bind_method(D_METHOD("set_trace_enabled", "enabled"), &TextToSpeech::set_trace_enabled);
+    ClassDB::bind_method(D_METHOD("get_trace_enabled"), &TextToSpeech::get_trace_enabled);
+    ClassDB::bind_method(D_METHOD("export_trace", "path"), &TextToSpeech::export_trace, DEFVAL("user://tts_trace.json"));
+    ClassDB::bind_method(D_METHOD("clear_trace"), &TextToSpeech::clear_trace);
     ClassDB::bind_method(D_METHOD("set_max_sentences", "count"), &TextToSpeech::set_max_sentences);
     ClassDB::bind_method(D_METHOD("get_max_sentences"), &TextToSpeech::get_max_sentences);
+    ClassDB::bind_method(D_METHOD("set_idle_unload_timeout", "seconds"), &TextToSpeech::set_idle_unload_timeout);
+    ClassDB::bind_method(D_METHOD("get_idle_unload_timeout"), &TextToSpeech::get_idle_unload_timeout);
+
+    // Property getters/setters - backend
+    ClassDB::bind_method(D_METHOD("set_backend", "backend"), &TextToSpeech::set_backend);
+    ClassDB::bind_method(D_METHOD("get_backend"), &TextToSpeech::get_backend);
+    ClassDB::bind_method(D_METHOD("set_mock_latency", "seconds"), &TextToSpeech::set_mock_latency);
+    ClassDB::bind_method(D_METHOD("get_mock_latency"), &TextToSpeech::get_mock_latency);
+    ClassDB::bind_method(D_METHOD("set_mock_real_time_factor", "factor"), &TextToSpeech::set_mock_real_time_factor);
+    ClassDB::bind_method(D_METHOD("get_mock_real_time_factor"), &TextToSpeech::get_mock_real_time_factor);
 
     // Properties - voice
     ADD_PROPERTY(PropertyInfo(Variant::INT, "speaker_id", PROPERTY_HINT_RANGE, "0,100,1"),
@@ -70,11 +109,39 @@ void TextToSpeech::_bind_methods() {
                  "set_num_threads", "get_num_threads");
     ADD_PROPERTY(PropertyInfo(Variant::BOOL, "debug_mode"),
                  "set_debug_mode", "get_debug_mode");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "coalesce_requests"),
+                 "set_coalesce_requests", "get_coalesce_requests");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "parallel_workers", PROPERTY_HINT_RANGE, "1,8,1"),
+                 "set_parallel_workers", "get_parallel_workers");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "stream_lookahead", PROPERTY_HINT_RANGE, "0,120,0.5,suffix:s"),
+                 "set_stream_lookahead", "get_stream_lookahead");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_worker_thread_pool"),
+                 "set_use_worker_thread_pool", "get_use_worker_thread_pool");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "adaptive_chunking"),
+                 "set_adaptive_chunking", "get_adaptive_chunking");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "adaptive_chunk_margin", PROPERTY_HINT_RANGE, "0,10,0.1,suffix:s"),
+                 "set_adaptive_chunk_margin", "get_adaptive_chunk_margin");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "trace_enabled"),
+                 "set_trace_enabled", "get_trace_enabled");
     ADD_PROPERTY(PropertyInfo(Variant::INT, "max_sentences", PROPERTY_HINT_RANGE, "1,10,1"),
                  "set_max_sentences", "get_max_sentences");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "idle_unload_timeout", PROPERTY_HINT_RANGE, "0,3600,1,or_greater,suffix:s"),
+                 "set_idle_unload_timeout", "get_idle_unload_timeout");
+
+    // Properties - backend (applied at the next load_model)
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "backend", PROPERTY_HINT_ENUM, "Sherpa,Mock"),
+                 "set_backend", "get_backend");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "mock_latency", PROPERTY_HINT_RANGE, "0,5,0.001,suffix:s"),
+                 "set_mock_latency", "get_mock_latency");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "mock_real_time_factor", PROPERTY_HINT_RANGE, "0,2,0.01"),
+                 "set_mock_real_time_factor", "get_mock_real_time_factor");
+
+    BIND_ENUM_CONSTANT(BACKEND_SHERPA);
+    BIND_ENUM_CONSTANT(BACKEND_MOCK);
 
     // Signals
     ADD_SIGNAL(MethodInfo("model_loaded"));
+    ADD_SIGNAL(MethodInfo("model_unloaded"));
     ADD_SIGNAL(MethodInfo("speech_generated", PropertyInfo(Variant::OBJECT, "audio")));
     ADD_SIGNAL(MethodInfo("generation_started", PropertyInfo(Variant::INT, "request_id")));
     ADD_SIGNAL(MethodInfo("generation_completed", PropertyInfo(Variant::INT, "request_id"), PropertyInfo(Variant::OBJECT, "audio")));
@@ -87,49 +154,103 @@ void TextToSpeech::_bind_methods() {
         PropertyInfo(Variant::INT, "total_chunks"),
         PropertyInfo(Variant::OBJECT, "audio")));
     ADD_SIGNAL(MethodInfo("stream_completed", PropertyInfo(Variant::INT, "request_id")));
+
+    // Render-to-file signals
+    ADD_SIGNAL(MethodInfo("render_progress",
+        PropertyInfo(Variant::INT, "request_id"),
+        PropertyInfo(Variant::INT, "chunks_done"),
+        PropertyInfo(Variant::INT, "total_chunks")));
+    ADD_SIGNAL(MethodInfo("render_completed", PropertyInfo(Variant::INT, "request_id"), PropertyInfo(Variant::STRING, "path")));
 }
 
 TextToSpeech::TextToSpeech() {
-    tts = nullptr;
     speaker_id = 0;
     speed = 1.0f;
     model_loaded = false;
 }
 
 TextToSpeech::~TextToSpeech() {
-    // Stop worker thread first
+    // Stop worker threads first
     stop_worker_thread();
 
-    if (tts) {
-        SherpaOnnxDestroyOfflineTts(tts);
-        tts = nullptr;
+    // Unfinished renders would leave a partial file with a placeholder header
+    for (auto &entry : renders) {
+        TTSRenderEvent event;
+        event.request_id = entry.first;
+        event.chunks_done = entry.second.next_chunk;
+        event.total_chunks = entry.second.chunks.size();
+        event.finished = true;
+        event.success = false;
+        finish_render(entry.second, event);
+    }
+    renders.clear();
+
+    for (int i = 0; i < MAX_PARALLEL_WORKERS; i++) {
+        std::lock_guard<std::mutex> lock(engine_slots[i].mutex);
+        destroy_engine(engine_slots[i]);
     }
 }
 
 void TextToSpeech::start_worker_thread() {
+    // speak_async()/speak_streaming() may race to start the workers from
+    // several threads, so re-check under the lock
+    std::lock_guard<std::mutex> worker_lock(worker_mutex);
     if (thread_running.load()) return;
 
+    int count = std::max(1, std::min(parallel_workers.load(), static_cast<int>(MAX_PARALLEL_WORKERS)));
+    bool use_pool = use_worker_thread_pool.load();
+
     should_exit.store(false);
-    worker_thread = std::thread(&TextToSpeech::worker_thread_func, this);
-    thread_running.store(true);
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        worker_count = count;
+        pool_mode = use_pool;
+        thread_running.store(true);
+
+        // Pool tasks are only created while there is work to do
+        if (use_pool) {
+            dispatch_pool_tasks_locked();
+        }
+    }
+
+    if (!use_pool) {
+        for (int i = 0; i < count; i++) {
+            worker_threads.emplace_back(&TextToSpeech::worker_thread_func, this, i);
+        }
+    }
 }
 
 void TextToSpeech::stop_worker_thread() {
+    std::lock_guard<std::mutex> worker_lock(worker_mutex);
     if (!thread_running.load()) return;
 
     should_exit.store(true);
 
-    // Wake up the worker thread so it can exit
+    // Wake up the worker threads so they can exit
     {
         std::lock_guard<std::mutex> lock(queue_mutex);
-        work_condition.notify_one();
+        work_condition.notify_all();
     }
 
-    if (worker_thread.joinable()) {
-        worker_thread.join();
+    for (std::thread &worker : worker_threads) {
+        if (worker.joinable()) {
+            worker.join();
+        }
     }
+    worker_threads.clear();
 
-    thread_running.store(false);
+    // Pool tasks exit after their current job; stop dispatching and wait so
+    // none outlives the node
+    std::vector<int64_t> task_ids;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        thread_running.store(false);
+        task_ids.swap(pool_task_ids);
+        pool_retry_msec = 0;
+    }
+    for (int64_t task_id : task_ids) {
+        WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+    }
 }
 
 // Helper to check if path is already absolute (Windows drive letter or Unix root)
@@ -153,15 +274,53 @@ static String resolve_path(const String &path) {
     return ProjectSettings::get_singleton()->globalize_path(path);
 }
 
-void TextToSpeech::load_model(const String &model, const String &voices, const String &tokens, const String &data_dir,
-                              const String &lexicon, const String &dict, const String &language) {
-    // Cleanup existing model
-    if (tts) {
-        SherpaOnnxDestroyOfflineTts(tts);
-        tts = nullptr;
-        model_loaded = false;
+// Sum of the on-disk sizes of the model files, used as the resident-size estimate
+static uint64_t get_files_size(const String *paths, int count) {
+    uint64_t total = 0;
+    for (int i = 0; i < count; i++) {
+        if (paths[i].is_empty()) continue;
+        Ref<FileAccess> file = FileAccess::open(paths[i], FileAccess::READ);
+        if (file.is_valid()) {
+            total += file->get_length();
+        }
+    }
+    return total;
+}
+
+// Recursive on-disk size of a data directory (espeak-ng-data, dict), which
+// the engine loads alongside the model files
+static uint64_t get_directory_size(const String &path) {
+    if (path.is_empty()) return 0;
+
+    PackedStringArray files = DirAccess::get_files_at(path);
+    uint64_t total = 0;
+    for (int i = 0; i < files.size(); i++) {
+        String file_path = path.path_join(files[i]);
+        total += get_files_size(&file_path, 1);
+    }
+    PackedStringArray directories = DirAccess::get_directories_at(path);
+    for (int i = 0; i < directories.size(); i++) {
+        total += get_directory_size(path.path_join(directories[i]));
+    }
+    return total;
+}
+
+// Size of Godot's WorkerThreadPool (project setting, defaults to the core count)
+static int get_worker_pool_size() {
+    int max_threads = ProjectSettings::get_singleton()->get_setting("threading/worker_pool/max_threads", -1);
+    if (max_threads > 0) {
+        return max_threads;
     }
+    return OS::get_singleton()->get_processor_count();
+}
+
+static int64_t get_steady_msec() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
+void TextToSpeech::load_model(const String &model, const String &voices, const String &tokens, const String &data_dir,
+                              const String &lexicon, const String &dict, const String &language) {
     // Convert paths to absolute paths (handles both res:// and already-absolute paths)
     String abs_model = resolve_path(model);
     String abs_voices = resolve_path(voices);
@@ -170,23 +329,6 @@ void TextToSpeech::load_model(const String &model, const String &voices, const S
     String abs_lexicon = resolve_path(lexicon);
     String abs_dict = resolve_path(dict);
 
-    // Store paths
-    model_path = abs_model;
-    voices_path = abs_voices;
-    tokens_path = abs_tokens;
-    lexicon_path = abs_lexicon;
-    dict_dir = abs_dict;
-    lang = language;
-
-    // Convert to UTF8 - must keep these alive until after API call
-    CharString model_utf8 = abs_model.utf8();
-    CharString voices_utf8 = abs_voices.utf8();
-    CharString tokens_utf8 = abs_tokens.utf8();
-    CharString data_dir_utf8 = abs_data_dir.utf8();
-    CharString lexicon_utf8 = abs_lexicon.utf8();
-    CharString dict_utf8 = abs_dict.utf8();
-    CharString lang_utf8 = language.utf8();
-
     UtilityFunctions::print("TextToSpeech: Loading model from:");
     UtilityFunctions::print("  Model: ", abs_model);
     UtilityFunctions::print("  Voices: ", abs_voices);
@@ -202,36 +344,66 @@ void TextToSpeech::load_model(const String &model, const String &voices, const S
         UtilityFunctions::print("  Language: ", language);
     }
 
-    // Initialize config
-    SherpaOnnxOfflineTtsConfig config;
-    memset(&config, 0, sizeof(config));
+    const String model_files[] = { abs_model, abs_voices, abs_tokens, abs_lexicon };
+    uint64_t file_bytes = get_files_size(model_files, 4) + get_directory_size(abs_data_dir) + get_directory_size(abs_dict);
 
-    // Set Kokoro model config
-    config.model.kokoro.model = model_utf8.get_data();
-    config.model.kokoro.voices = voices_utf8.get_data();
-    config.model.kokoro.tokens = tokens_utf8.get_data();
-    config.model.kokoro.data_dir = data_dir_utf8.get_data();
-    config.model.kokoro.length_scale = 1.0f;
-    config.model.kokoro.dict_dir = dict_utf8.get_data();
-    config.model.kokoro.lexicon = lexicon_utf8.get_data();
-    config.model.kokoro.lang = lang_utf8.get_data();
+    // Let in-flight work finish on the old engines; queued work is kept and
+    // the workers restart (picking up a changed parallel_workers) afterwards.
+    // They restart even if loading fails, so queued work then fails with
+    // generation_failed instead of waiting forever
+    bool restart_workers = thread_running.load();
+    stop_worker_thread();
 
-    // General model config - use dynamic thread count
-    int effective_threads = (num_threads <= 0) ? get_optimal_thread_count() : num_threads;
-    config.model.num_threads = effective_threads;
-    config.model.debug = debug_mode ? 1 : 0;
-    config.model.provider = "cpu";
+    bool loaded = false;
+    {
+        // Swap engines with every slot locked: a concurrent speak() finishes
+        // on the old engine before it is destroyed
+        std::unique_lock<std::mutex> slot_locks[MAX_PARALLEL_WORKERS];
+        for (int i = 0; i < MAX_PARALLEL_WORKERS; i++) {
+            slot_locks[i] = std::unique_lock<std::mutex>(engine_slots[i].mutex);
+            destroy_engine(engine_slots[i]);
+        }
 
-    // TTS config
-    config.max_num_sentences = max_sentences;
+        {
+            std::lock_guard<std::mutex> lock(config_mutex);
+            model_loaded.store(false);
+            cached_sample_rate.store(0);
+            cached_speaker_count.store(0);
+
+            // Store paths (reused when idle-unloaded or extra engines are created)
+            model_path = abs_model;
+            voices_path = abs_voices;
+            tokens_path = abs_tokens;
+            data_dir_path = abs_data_dir;
+            lexicon_path = abs_lexicon;
+            dict_dir = abs_dict;
+            lang = language;
+            model_file_bytes.store(file_bytes);
+        }
 
-    UtilityFunctions::print("TextToSpeech: Using ", effective_threads, " CPU threads (debug=", debug_mode ? "on" : "off", ")");
+        // Only the first engine is created up front; workers beyond the first
+        // create theirs on first use
+        TTSEngineSlot &slot = engine_slots[0];
+        if (create_engine(slot, get_engine_config())) {
+            cached_sample_rate.store(slot.engine->get_sample_rate());
+            cached_speaker_count.store(slot.engine->get_speaker_count());
+            model_loaded.store(true);
+            loaded = true;
+        }
+    }
 
-    // Create TTS engine
-    tts = SherpaOnnxCreateOfflineTts(&config);
+    // Synthesis speed is measured afresh for the new model/backend
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        measured_rtf = 0.0f;
+        measured_seconds_per_char = 0.0f;
+    }
+
+    if (restart_workers) {
+        start_worker_thread();
+    }
 
-    if (tts) {
-        model_loaded = true;
+    if (loaded) {
         UtilityFunctions::print("TextToSpeech: Model loaded successfully");
         UtilityFunctions::print("  Speakers: ", get_speaker_count());
         UtilityFunctions::print("  Sample rate: ", get_sample_rate(), " Hz");
@@ -244,71 +416,389 @@ void TextToSpeech::load_model(const String &model, const String &voices, const S
     }
 }
 
-bool TextToSpeech::is_model_loaded() const {
-    return model_loaded && tts != nullptr;
+// Backend config from the stored paths and current performance settings
+TTSBackendConfig TextToSpeech::get_engine_config() const {
+    TTSBackendConfig config;
+    {
+        std::lock_guard<std::mutex> lock(config_mutex);
+        config.model_path = model_path;
+        config.voices_path = voices_path;
+        config.tokens_path = tokens_path;
+        config.data_dir = data_dir_path;
+        config.lexicon_path = lexicon_path;
+        config.dict_dir = dict_dir;
+        config.lang = lang;
+    }
+
+    // General model config - use dynamic thread count, shared between the
+    // parallel engines so they do not oversubscribe the CPU
+    int requested_threads = num_threads.load();
+    int effective_threads = (requested_threads <= 0) ? get_optimal_thread_count() : requested_threads;
+    if (requested_threads <= 0 && use_worker_thread_pool.load()) {
+        // The synthesis tasks already occupy pool threads and ORT's caller
+        // thread joins intra-op work, so leave half the pool to the game
+        effective_threads = std::min(effective_threads, std::max(1, get_worker_pool_size() / 2));
+    }
+    config.num_threads = std::max(1, effective_threads / std::max(1, parallel_workers.load()));
+    config.debug = debug_mode;
+    config.max_sentences = max_sentences;
+    return config;
 }
 
-// Internal audio generation with buffer reuse (thread-safe for worker thread)
-Ref<AudioStreamWAV> TextToSpeech::generate_audio_internal(const String &text, int sid, float spd) {
-    Ref<AudioStreamWAV> wav;
+// Create a slot's synthesis backend (caller holds slot.mutex)
+bool TextToSpeech::create_engine(TTSEngineSlot &slot, const TTSBackendConfig &config) {
+    TTSTraceScope trace(tracer, "engine_create");
+    UtilityFunctions::print("TextToSpeech: Using ", config.num_threads, " CPU threads (debug=", config.debug ? "on" : "off", ")");
 
-    if (!tts) {
-        return wav;
+    // Create TTS engine
+    if (backend_type == BACKEND_MOCK) {
+        slot.engine.reset(new MockBackend(mock_latency, mock_real_time_factor));
+    } else {
+        slot.engine.reset(new SherpaBackend());
+    }
+    if (!slot.engine->create(config)) {
+        slot.engine.reset();
+        return false;
+    }
+
+    resident_engines.fetch_add(1);
+    touch_activity();
+    return true;
+}
+
+// Release a slot's engine and scratch buffer (caller holds slot.mutex)
+void TextToSpeech::destroy_engine(TTSEngineSlot &slot) {
+    if (slot.engine) {
+        slot.engine.reset();
+        resident_engines.fetch_sub(1);
     }
+    pcm_buffer_bytes.fetch_sub(slot.pcm_buffer.size());
+    slot.pcm_buffer = PackedByteArray();
+}
 
-    // Keep text UTF8 alive during API call
-    CharString text_utf8 = text.utf8();
+// Create an idle-unloaded or not yet used engine on demand (caller holds slot.mutex)
+bool TextToSpeech::ensure_engine(TTSEngineSlot &slot) {
+    if (slot.engine) return true;
+    if (!model_loaded.load()) return false;
 
-    // Generate audio
-    const SherpaOnnxGeneratedAudio *audio =
-        SherpaOnnxOfflineTtsGenerate(tts, text_utf8.get_data(), sid, spd);
+    if (debug_mode) {
+        UtilityFunctions::print("TextToSpeech: Creating synthesis engine on demand");
+    }
+    if (!create_engine(slot, get_engine_config())) {
+        UtilityFunctions::printerr("TextToSpeech: Failed to reload model");
+        return false;
+    }
+    return true;
+}
 
-    if (!audio || audio->n <= 0) {
-        if (audio) {
-            SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
-        }
-        return wav;
+void TextToSpeech::touch_activity() {
+    last_activity_msec.store(get_steady_msec());
+}
+
+// Release the engines after idle_unload_timeout seconds without any work
+void TextToSpeech::check_idle_unload() {
+    float timeout = idle_unload_timeout.load();
+    if (timeout <= 0.0f || !model_loaded.load() || resident_engines.load() == 0) return;
+
+    if (get_steady_msec() - last_activity_msec.load() < static_cast<int64_t>(timeout * 1000.0f)) return;
+    if (is_generating()) return;
+
+    // Never block the main thread: if a worker just picked up work it owns
+    // its engine and we try again next frame
+    std::unique_lock<std::mutex> slot_locks[MAX_PARALLEL_WORKERS];
+    for (int i = 0; i < MAX_PARALLEL_WORKERS; i++) {
+        slot_locks[i] = std::unique_lock<std::mutex>(engine_slots[i].mutex, std::try_to_lock);
+        if (!slot_locks[i].owns_lock()) return;
+    }
+
+    for (int i = 0; i < MAX_PARALLEL_WORKERS; i++) {
+        destroy_engine(engine_slots[i]);
+        slot_locks[i].unlock();
     }
 
-    // Reuse PCM buffer if large enough, otherwise resize
-    size_t required_size = static_cast<size_t>(audio->n) * 2;
-    if (pcm_buffer.size() < static_cast<int64_t>(required_size)) {
-        pcm_buffer.resize(required_size);
+    if (debug_mode) {
+        UtilityFunctions::print("TextToSpeech: Model unloaded after ", timeout, "s idle");
     }
+    emit_signal("model_unloaded");
+}
+
+bool TextToSpeech::is_engine_resident() const {
+    return resident_engines.load() > 0;
+}
+
+bool TextToSpeech::is_model_loaded() const {
+    return model_loaded.load();
+}
 
-    int16_t *pcm = reinterpret_cast<int16_t*>(pcm_buffer.ptrw());
+// Samples converted per block when rendering to a file
+static const int32_t RENDER_BLOCK_SAMPLES = 16384;
 
-    // Convert float samples to 16-bit PCM (SIMD-friendly loop)
-    for (int32_t i = 0; i < audio->n; i++) {
-        float sample = audio->samples[i];
+// Convert float samples to 16-bit PCM (SIMD-friendly loop)
+static void convert_to_pcm16(const float *samples, int32_t count, int16_t *pcm) {
+    for (int32_t i = 0; i < count; i++) {
+        float sample = samples[i];
         // Clamp to [-1, 1] and convert to 16-bit
         sample = (sample > 1.0f) ? 1.0f : ((sample < -1.0f) ? -1.0f : sample);
         pcm[i] = static_cast<int16_t>(sample * 32767.0f);
     }
+}
+
+// 44-byte header of a 16-bit mono PCM WAV file
+static void write_wav_header(const Ref<FileAccess> &file, int sample_rate, uint32_t data_bytes) {
+    file->store_string("RIFF");
+    file->store_32(36 + data_bytes);
+    file->store_string("WAVE");
+    file->store_string("fmt ");
+    file->store_32(16);               // fmt chunk size
+    file->store_16(1);                // PCM
+    file->store_16(1);                // Mono
+    file->store_32(sample_rate);
+    file->store_32(sample_rate * 2);  // Byte rate
+    file->store_16(2);                // Block align
+    file->store_16(16);               // Bits per sample
+    file->store_string("data");
+    file->store_32(data_bytes);
+}
+
+// Internal audio generation (thread-safe: serialized per engine slot). The
+// samples reach `sink` while the slot is still locked. Workers pass their own
+// slot; other callers (slot_index < 0) take any idle slot. Stage spans are
+// tagged with trace_id/trace_chunk.
+bool TextToSpeech::generate_with_engine(const String &text, int sid, float spd, int slot_index, uint64_t trace_id, int trace_chunk,
+        const TTSAudioSink &sink) {
+    // Held for the whole call: protects both the engine and its pcm_buffer
+    int64_t wait_start = tracer.timestamp();
+    std::unique_lock<std::mutex> lock;
+    if (slot_index >= 0) {
+        lock = std::unique_lock<std::mutex>(engine_slots[slot_index].mutex);
+    } else {
+        int count = std::max(1, std::min(parallel_workers.load(), static_cast<int>(MAX_PARALLEL_WORKERS)));
+        for (int i = 0; i < count && !lock.owns_lock(); i++) {
+            lock = std::unique_lock<std::mutex>(engine_slots[i].mutex, std::try_to_lock);
+            slot_index = i;
+        }
+        if (!lock.owns_lock()) {
+            slot_index = 0;
+            lock = std::unique_lock<std::mutex>(engine_slots[0].mutex);
+        }
+    }
+    TTSEngineSlot &slot = engine_slots[slot_index];
+    if (wait_start > 0) {
+        tracer.add_span("engine_wait", wait_start, TTSTracer::now_usec(), trace_id, trace_chunk);
+    }
+
+    if (!ensure_engine(slot)) {
+        return false;
+    }
+    touch_activity();
+
+    TTSTraceScope trace(tracer, "synthesize", trace_id, trace_chunk);
+
+    // Time the engine call and count its output to track the real-time factor
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+    int64_t sample_count = 0;
+    int32_t sample_rate = 0;
+    int64_t trace_start = tracer.timestamp();
+    bool generated = slot.engine->generate(text, sid, spd, [&](const float *samples, int32_t count, int32_t rate) {
+        // Everything before the first samples is G2P plus ONNX inference;
+        // sherpa-onnx does not report the two separately
+        if (sample_count == 0 && trace_start > 0) {
+            tracer.add_span("inference", trace_start, TTSTracer::now_usec(), trace_id, trace_chunk);
+        }
+        sample_count += count;
+        sample_rate = rate;
+        sink(samples, count, rate);
+    });
+
+    if (generated && sample_count > 0 && sample_rate > 0) {
+        float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - started).count();
+        record_generation(elapsed, static_cast<float>(sample_count) / sample_rate, text.length(), spd);
+    }
+
+    touch_activity();
+    return generated;
+}
+
+// Fold one generation into the running synthesis-speed estimates
+void TextToSpeech::record_generation(float elapsed_seconds, float audio_seconds, int64_t characters, float spd) {
+    if (audio_seconds <= 0.0f || characters <= 0) return;
 
-    int sample_rate = audio->sample_rate;
-    int num_samples = audio->n;
+    // Exponential moving average: recent generations dominate, so the
+    // estimate follows thermal throttling or competing load
+    const float weight = 0.25f;
+    float rtf = elapsed_seconds / audio_seconds;
+    float seconds_per_char = audio_seconds * spd / characters;
 
-    // Cleanup sherpa audio
-    SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    if (measured_rtf <= 0.0f) {
+        measured_rtf = rtf;
+        measured_seconds_per_char = seconds_per_char;
+    } else {
+        measured_rtf += weight * (rtf - measured_rtf);
+        measured_seconds_per_char += weight * (seconds_per_char - measured_seconds_per_char);
+    }
+}
 
-    // Create Godot AudioStreamWAV with a copy of the data
+Ref<AudioStreamWAV> TextToSpeech::generate_audio_internal(const String &text, int sid, float spd, int slot_index,
+        uint64_t trace_id, int trace_chunk) {
+    Ref<AudioStreamWAV> wav;
     PackedByteArray audio_data;
-    audio_data.resize(num_samples * 2);
-    memcpy(audio_data.ptrw(), pcm_buffer.ptr(), num_samples * 2);
+    int sample_rate = 0;
+
+    // Convert straight into the stream's buffer so the samples are only
+    // copied once more, by set_data()
+    bool generated = generate_with_engine(text, sid, spd, slot_index, trace_id, trace_chunk,
+            [&](const float *samples, int32_t count, int32_t rate) {
+        if (count <= 0) return;
+
+        TTSTraceScope trace(tracer, "pcm_convert", trace_id, trace_chunk);
+        int64_t offset = audio_data.size();
+        audio_data.resize(offset + static_cast<int64_t>(count) * 2);
+        convert_to_pcm16(samples, count, reinterpret_cast<int16_t*>(audio_data.ptrw() + offset));
+        sample_rate = rate;
+    });
+
+    if (!generated || audio_data.is_empty()) {
+        return wav;
+    }
 
+    TTSTraceScope trace(tracer, "wav_create", trace_id, trace_chunk);
     wav.instantiate();
     wav->set_format(AudioStreamWAV::FORMAT_16_BITS);
     wav->set_mix_rate(sample_rate);
     wav->set_stereo(false);
     wav->set_data(audio_data);
-
     return wav;
 }
 
+// Synthesize the next chunk of a render and append it to the render's file
+void TextToSpeech::render_chunk(int slot_index, const TTSChunk &chunk) {
+    Ref<FileAccess> file;
+    int sample_rate;  // 0 until the first chunk has been written
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        const TTSRenderJob &job = renders[chunk.request_id];
+        file = job.file;
+        sample_rate = job.sample_rate;
+    }
+
+    // Convert and write in fixed-size blocks through the slot's scratch
+    // buffer, so memory stays bounded however long the chunk is
+    int64_t written = 0;
+    bool rate_mismatch = false;
+    bool generated = generate_with_engine(chunk.text, chunk.speaker_id, chunk.speed, slot_index,
+            chunk.request_id, chunk.chunk_index, [&](const float *samples, int32_t count, int32_t rate) {
+        // The file has a single header, so every sample must share its rate
+        if (sample_rate == 0) {
+            sample_rate = rate;
+        }
+        if (rate != sample_rate || rate_mismatch) {
+            rate_mismatch = true;
+            return;
+        }
+
+        TTSTraceScope trace(tracer, "file_write", chunk.request_id, chunk.chunk_index);
+        PackedByteArray &pcm = engine_slots[slot_index].pcm_buffer;
+        if (pcm.size() != RENDER_BLOCK_SAMPLES * 2) {
+            pcm_buffer_bytes.fetch_add(RENDER_BLOCK_SAMPLES * 2 - pcm.size());
+            pcm.resize(RENDER_BLOCK_SAMPLES * 2);
+        }
+
+        for (int32_t offset = 0; offset < count; offset += RENDER_BLOCK_SAMPLES) {
+            int32_t block = std::min(count - offset, RENDER_BLOCK_SAMPLES);
+            convert_to_pcm16(samples + offset, block, reinterpret_cast<int16_t*>(pcm.ptrw()));
+            file->store_buffer(block == RENDER_BLOCK_SAMPLES ? pcm : pcm.slice(0, block * 2));
+            written += static_cast<int64_t>(block) * 2;
+        }
+    });
+
+    TTSRenderEvent event;
+    event.request_id = chunk.request_id;
+    event.chunks_done = chunk.chunk_index + 1;
+    event.total_chunks = chunk.total_chunks;
+    event.finished = false;
+    event.success = true;
+    if (!generated || file->get_error() != OK) {
+        event.finished = true;
+        event.success = false;
+        event.error_message = "Failed to render chunk " + String::num_int64(chunk.chunk_index);
+    } else if (rate_mismatch) {
+        event.finished = true;
+        event.success = false;
+        event.error_message = "Sample rate changed during render at chunk " + String::num_int64(chunk.chunk_index);
+    }
+
+    TTSRenderJob done;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        auto it = renders.find(chunk.request_id);
+        TTSRenderJob &job = it->second;
+        job.running = false;
+        job.next_chunk++;
+        job.data_bytes += written;
+        job.sample_rate = sample_rate;
+
+        if (event.success && job.cancelled) {
+            event.finished = true;
+            event.success = false;
+            event.error_message = "Render cancelled";
+        } else if (job.next_chunk >= job.chunks.size()) {
+            event.finished = true;
+        }
+
+        if (!event.finished) {
+            job.queued_usec = tracer.timestamp();
+            event.ready_usec = job.queued_usec;
+
+            // Publish before the next chunk can be taken so progress stays in
+            // order (queue_mutex -> result_mutex is the only nesting of the two)
+            {
+                std::lock_guard<std::mutex> result_lock(result_mutex);
+                render_event_queue.push_back(event);
+            }
+            notify_work_locked();
+            return;
+        }
+
+        done = job;
+        renders.erase(it);
+    }
+
+    finish_render(done, event);
+    event.ready_usec = tracer.timestamp();
+
+    std::lock_guard<std::mutex> lock(result_mutex);
+    render_event_queue.push_back(event);
+}
+
+// Close a render that is no longer scheduled. Complete renders get their
+// final header sizes; failed or cancelled ones are deleted
+void TextToSpeech::finish_render(TTSRenderJob &job, TTSRenderEvent &event) {
+    event.path = job.path;
+    if (event.success) {
+        job.file->seek(0);
+        write_wav_header(job.file, job.sample_rate, static_cast<uint32_t>(job.data_bytes));
+        if (job.file->get_error() != OK) {
+            event.success = false;
+            event.error_message = "Failed to finalize " + job.path;
+        }
+    }
+    job.file->close();
+    job.file.unref();
+
+    if (!event.success) {
+        DirAccess::remove_absolute(job.path);
+    }
+
+    if (debug_mode) {
+        UtilityFunctions::print("TextToSpeech: Render #", event.request_id, event.success ? " wrote " : " dropped ",
+            job.path, " (", job.data_bytes, " bytes of audio)");
+    }
+}
+
 // Synchronous speech generation (blocks until complete)
 Ref<AudioStreamWAV> TextToSpeech::speak(const String &text) {
-    if (!tts) {
+    if (!is_model_loaded()) {
         UtilityFunctions::printerr("TextToSpeech: Model not loaded");
         return Ref<AudioStreamWAV>();
     }
@@ -318,12 +808,18 @@ Ref<AudioStreamWAV> TextToSpeech::speak(const String &text) {
         return Ref<AudioStreamWAV>();
     }
 
+    int sid = speaker_id.load();
+    float spd = speed.load();
+
     if (debug_mode) {
         UtilityFunctions::print("TextToSpeech: Generating speech for: ", text);
-        UtilityFunctions::print("  Speaker ID: ", speaker_id, ", Speed: ", speed);
+        UtilityFunctions::print("  Speaker ID: ", sid, ", Speed: ", spd);
     }
 
-    Ref<AudioStreamWAV> wav = generate_audio_internal(text, speaker_id, speed);
+    // Sync calls only get an id of their own while tracing, to group their spans
+    uint64_t trace_id = tracer.is_enabled() ? next_request_id.fetch_add(1) : 0;
+    TTSTraceScope trace(tracer, "speak", trace_id);
+    Ref<AudioStreamWAV> wav = generate_audio_internal(text, sid, spd, -1, trace_id);
 
     if (wav.is_valid()) {
         if (debug_mode) {
@@ -339,8 +835,12 @@ Ref<AudioStreamWAV> TextToSpeech::speak(const String &text) {
 }
 
 // Async speech generation (non-blocking)
+static bool is_same_request(const TTSRequest &a, const TTSRequest &b) {
+    return a.speaker_id == b.speaker_id && a.speed == b.speed && a.text == b.text;
+}
+
 uint64_t TextToSpeech::speak_async(const String &text) {
-    if (!tts) {
+    if (!is_model_loaded()) {
         UtilityFunctions::printerr("TextToSpeech: Model not loaded");
         return 0;
     }
@@ -351,224 +851,768 @@ uint64_t TextToSpeech::speak_async(const String &text) {
     }
 
     // Start worker thread if not running
-    if (!thread_running.load()) {
-        start_worker_thread();
-    }
+    start_worker_thread();
 
     uint64_t request_id = next_request_id.fetch_add(1);
 
     TTSRequest request;
     request.text = text;
-    request.speaker_id = speaker_id;
-    request.speed = speed;
+    request.speaker_id = speaker_id.load();
+    request.speed = speed.load();
     request.request_id = request_id;
+    request.queued_usec = tracer.timestamp();
 
+    uint64_t coalesced_into = 0;
     {
         std::lock_guard<std::mutex> lock(queue_mutex);
-        request_queue.push(request);
-        work_condition.notify_one();
+
+        // Language is fixed per loaded model, so text/speaker/speed identify the output
+        TTSRequest *existing = nullptr;
+        if (coalesce_requests) {
+            for (auto &entry : active_requests) {
+                if (is_same_request(entry.second, request)) {
+                    existing = &entry.second;
+                    break;
+                }
+            }
+            for (size_t i = 0; !existing && i < request_queue.size(); i++) {
+                if (is_same_request(request_queue[i], request)) {
+                    existing = &request_queue[i];
+                }
+            }
+        }
+
+        if (existing) {
+            existing->coalesced_ids.push_back(request_id);
+            coalesced_into = existing->request_id;
+        } else {
+            request_queue.push_back(request);
+            notify_work_locked();
+        }
     }
 
     // Emit signal using call_deferred for thread safety
     call_deferred("emit_signal", "generation_started", request_id);
 
     if (debug_mode) {
-        UtilityFunctions::print("TextToSpeech: Queued async request #", request_id, " for: ", text);
+        if (coalesced_into) {
+            UtilityFunctions::print("TextToSpeech: Async request #", request_id, " shares request #", coalesced_into, " for: ", text);
+        } else {
+            UtilityFunctions::print("TextToSpeech: Queued async request #", request_id, " for: ", text);
+        }
     }
 
     return request_id;
 }
 
-void TextToSpeech::worker_thread_func() {
-    while (!should_exit.load()) {
-        bool has_work = false;
-        bool is_chunk = false;
-        TTSRequest request;
-        TTSChunk chunk;
+// How long until a stream's synthesized audio no longer runs more than
+// `lookahead` seconds ahead of its estimated playback position
+static int64_t get_lookahead_delay_msec(const TTSStreamSchedule &schedule, int64_t now, float lookahead) {
+    // Nothing finished yet: let the first chunks start in parallel
+    if (lookahead <= 0.0f || schedule.chunks_done == 0) return 0;
+
+    float average_chunk = schedule.audio_seconds / schedule.chunks_done;
+    float played = (now - schedule.first_ready_msec) / 1000.0f;
+    float ahead = schedule.audio_seconds + average_chunk * schedule.in_flight - played;
+    if (ahead < lookahead) return 0;
+    return static_cast<int64_t>((ahead - lookahead) * 1000.0f) + 1;
+}
 
-        // Wait for work (either regular request or chunk)
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            work_condition.wait(lock, [this] {
-                return should_exit.load() || !request_queue.empty() || !chunk_queue.empty();
-            });
-
-            if (should_exit.load()) break;
-
-            // Prioritize chunks for lower latency streaming
-            if (!chunk_queue.empty()) {
-                chunk = chunk_queue.front();
-                chunk_queue.pop();
-                is_chunk = true;
-                has_work = true;
-            } else if (!request_queue.empty()) {
-                request = request_queue.front();
-                request_queue.pop();
-                is_chunk = false;
-                has_work = true;
-            }
+// Pick the next job (caller holds queue_mutex). Returns false if nothing may
+// start yet; wait_msec is then how long until a throttled stream frees up (-1 = none).
+bool TextToSpeech::take_work_locked(TTSChunk &chunk, TTSRequest &request, TTSJobType &type, int64_t &wait_msec) {
+    int64_t now = get_steady_msec();
+    float lookahead = stream_lookahead.load();
+    wait_msec = -1;
+
+    // Prioritize chunks for lower latency streaming. Only the earliest queued
+    // chunk of each stream is a candidate, so chunks start in index order
+    std::vector<uint64_t> seen_streams;
+    for (size_t i = 0; i < chunk_queue.size(); i++) {
+        uint64_t stream_id = chunk_queue[i].request_id;
+        if (std::find(seen_streams.begin(), seen_streams.end(), stream_id) != seen_streams.end()) {
+            continue;
         }
+        seen_streams.push_back(stream_id);
 
-        if (!has_work) continue;
+        TTSStreamSchedule &schedule = stream_schedule[stream_id];
+        int64_t delay = get_lookahead_delay_msec(schedule, now, lookahead);
+        if (delay > 0) {
+            if (wait_msec < 0 || delay < wait_msec) wait_msec = delay;
+            continue;
+        }
 
-        generation_in_progress.store(true);
+        chunk = chunk_queue[i];
+        chunk_queue.erase(chunk_queue.begin() + i);
+        schedule.in_flight++;
+        type = TTS_JOB_CHUNK;
+        return true;
+    }
 
-        if (is_chunk) {
-            // Generate audio for chunk
-            TTSChunkResult result;
-            result.request_id = chunk.request_id;
-            result.chunk_index = chunk.chunk_index;
-            result.total_chunks = chunk.total_chunks;
-            result.audio = generate_audio_internal(chunk.text, chunk.speaker_id, chunk.speed);
-            result.success = result.audio.is_valid();
+    if (!request_queue.empty()) {
+        request = request_queue.front();
+        request_queue.pop_front();
 
-            if (!result.success) {
-                result.error_message = "Failed to generate chunk audio";
-            }
+        // Keep it visible to speak_async() so duplicates can still attach
+        active_requests[request.request_id] = request;
+        type = TTS_JOB_REQUEST;
+        return true;
+    }
 
-            // Store chunk result for main thread
-            {
-                std::lock_guard<std::mutex> lock(result_mutex);
-                chunk_result_queue.push(result);
-            }
-        } else {
-            // Generate audio for regular request
-            TTSResult result;
-            result.request_id = request.request_id;
-            result.audio = generate_audio_internal(request.text, request.speaker_id, request.speed);
-            result.success = result.audio.is_valid();
-
-            if (!result.success) {
-                result.error_message = "Failed to generate audio";
-            }
+    // Renders run in the background, one chunk at a time so their file is
+    // appended in order
+    for (auto &entry : renders) {
+        TTSRenderJob &job = entry.second;
+        if (job.running || job.cancelled) continue;
+
+        chunk.text = job.chunks[job.next_chunk];
+        chunk.speaker_id = job.speaker_id;
+        chunk.speed = job.speed;
+        chunk.request_id = entry.first;
+        chunk.chunk_index = job.next_chunk;
+        chunk.total_chunks = job.chunks.size();
+        chunk.is_streaming = false;
+        chunk.queued_usec = job.queued_usec;
+        job.running = true;
+        type = TTS_JOB_RENDER;
+        return true;
+    }
 
-            // Store result for main thread
-            {
-                std::lock_guard<std::mutex> lock(result_mutex);
-                result_queue.push(result);
-            }
-        }
+    return false;
+}
 
-        generation_in_progress.store(false);
+// Jobs a worker could pick up right now, ignoring lookahead (caller holds queue_mutex)
+int TextToSpeech::count_pending_jobs_locked() const {
+    int pending = static_cast<int>(request_queue.size() + chunk_queue.size());
+    for (const auto &entry : renders) {
+        if (!entry.second.running && !entry.second.cancelled) pending++;
     }
+    return pending;
 }
 
-void TextToSpeech::process_pending_results() {
-    std::lock_guard<std::mutex> lock(result_mutex);
+// Update a stream's lookahead accounting after a chunk (caller holds queue_mutex)
+void TextToSpeech::finish_chunk_locked(const TTSChunkResult &result) {
+    auto it = stream_schedule.find(result.request_id);
+    if (it == stream_schedule.end()) return;
 
-    // Process regular results
-    while (!result_queue.empty()) {
-        TTSResult result = result_queue.front();
-        result_queue.pop();
+    TTSStreamSchedule &schedule = it->second;
+    schedule.in_flight--;
+    if (result.success) {
+        if (schedule.chunks_done == 0) {
+            schedule.first_ready_msec = get_steady_msec();
+        }
+        schedule.chunks_done++;
+        schedule.audio_seconds += static_cast<float>(result.audio->get_data().size()) / 2 / result.audio->get_mix_rate();
+    }
 
-        if (result.success) {
-            emit_signal("generation_completed", result.request_id, result.audio);
-            emit_signal("speech_generated", result.audio);  // Backwards compatibility
-        } else {
-            emit_signal("generation_failed", result.request_id, result.error_message);
+    // Drop the entry once nothing of this stream is queued or running
+    if (schedule.in_flight <= 0) {
+        for (const TTSChunk &queued : chunk_queue) {
+            if (queued.request_id == result.request_id) return;
         }
+        stream_schedule.erase(it);
     }
+}
 
-    // Process chunk results for streaming
-    while (!chunk_result_queue.empty()) {
-        TTSChunkResult result = chunk_result_queue.front();
-        chunk_result_queue.pop();
+void TextToSpeech::worker_thread_func(int slot_index) {
+    tracer.name_current_thread("TTS worker " + String::num_int64(slot_index));
 
-        if (result.success) {
-            emit_signal("chunk_ready", result.request_id, result.chunk_index,
-                        result.total_chunks, result.audio);
+    while (!should_exit.load()) {
+        TTSJobType type = TTS_JOB_REQUEST;
+        TTSRequest request;
+        TTSChunk chunk;
 
-            // If this was the last chunk, emit stream_completed
-            if (result.chunk_index == result.total_chunks - 1) {
-                emit_signal("stream_completed", result.request_id);
+        // Wait for work (either regular request or chunk)
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            int64_t wait_msec = -1;
+            bool has_work = false;
+            while (!should_exit.load()) {
+                has_work = take_work_locked(chunk, request, type, wait_msec);
+                if (has_work) break;
+                if (wait_msec < 0) {
+                    work_condition.wait(lock);
+                } else {
+                    work_condition.wait_for(lock, std::chrono::milliseconds(wait_msec));
+                }
+            }
+
+            // A popped job always runs, even if a stop was requested meanwhile;
+            // dropping it would lose its signals and leave it marked as running
+            if (!has_work) break;
+
+            // Mark busy while still holding the lock so is_generating() never
+            // sees an empty queue before the popped work has started
+            generations_in_progress++;
+
+            // Hand whatever is left to another idle worker
+            if (count_pending_jobs_locked() > 0) {
+                work_condition.notify_one();
             }
-        } else {
-            emit_signal("generation_failed", result.request_id, result.error_message);
         }
-    }
-}
 
-void TextToSpeech::_process(double delta) {
-    // Check for completed async results and emit signals on main thread
-    process_pending_results();
+        run_job(slot_index, type, chunk, request);
+    }
 }
 
-bool TextToSpeech::is_generating() const {
-    return generation_in_progress.load() || !request_queue.empty() || !chunk_queue.empty();
-}
+// WorkerThreadPool mode: claim a free engine slot and drain the queues, then
+// hand the pool thread back instead of idling on it
+void TextToSpeech::pool_task_func() {
+    if (tracer.is_enabled()) {
+        tracer.name_current_thread("WorkerThreadPool");
+    }
 
-void TextToSpeech::cancel_generation() {
-    // Clear pending requests
+    int slot_index = -1;
     {
         std::lock_guard<std::mutex> lock(queue_mutex);
-        while (!request_queue.empty()) {
-            request_queue.pop();
+        for (int i = 0; i < worker_count && slot_index < 0; i++) {
+            if (!pool_slot_in_use[i]) {
+                pool_slot_in_use[i] = true;
+                slot_index = i;
+            }
         }
-        while (!chunk_queue.empty()) {
-            chunk_queue.pop();
+        if (slot_index < 0) {
+            pool_tasks_running--;
+            return;
         }
     }
-    // Note: Cannot cancel in-progress generation without modifying sherpa-onnx
-}
 
-// Split text into chunks for streaming TTS
-PackedStringArray TextToSpeech::split_into_chunks(const String &text) {
-    PackedStringArray chunks;
+    while (true) {
+        TTSJobType type = TTS_JOB_REQUEST;
+        TTSRequest request;
+        TTSChunk chunk;
 
-    if (text.is_empty()) {
-        return chunks;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            int64_t wait_msec = -1;
+            if (should_exit.load() || !take_work_locked(chunk, request, type, wait_msec)) {
+                // Throttled streams are re-dispatched from _process once they may run.
+                // Release in the same critical section so new work never sees a
+                // task that is about to exit
+                if (wait_msec >= 0) {
+                    int64_t retry = get_steady_msec() + wait_msec;
+                    if (pool_retry_msec == 0 || retry < pool_retry_msec) pool_retry_msec = retry;
+                }
+                pool_slot_in_use[slot_index] = false;
+                pool_tasks_running--;
+                return;
+            }
+            generations_in_progress++;
+        }
+
+        run_job(slot_index, type, chunk, request);
     }
+}
 
-    // Split by sentence-ending punctuation: . ! ?
-    String current_chunk;
-    bool in_sentence = false;
+// Queue enough pool tasks for the pending work (caller holds queue_mutex)
+void TextToSpeech::dispatch_pool_tasks_locked() {
+    int pending = count_pending_jobs_locked();
+    while (pending > 0 && pool_tasks_running < worker_count) {
+        pool_task_ids.push_back(WorkerThreadPool::get_singleton()->add_task(
+                callable_mp(this, &TextToSpeech::pool_task_func), false, "TextToSpeech synthesis"));
+        pool_tasks_running++;
+        pending--;
+    }
+}
 
-    for (int i = 0; i < text.length(); i++) {
-        char32_t c = text[i];
-        current_chunk += String::chr(c);
+// Wake a worker for newly queued work (caller holds queue_mutex)
+void TextToSpeech::notify_work_locked() {
+    if (!pool_mode) {
+        work_condition.notify_one();
+    } else if (thread_running.load()) {
+        dispatch_pool_tasks_locked();
+    }
+}
 
-        // Check for sentence-ending punctuation
-        if (c == '.' || c == '!' || c == '?') {
-            // Look ahead for closing quotes or parentheses
-            while (i + 1 < text.length()) {
-                char32_t next = text[i + 1];
-                if (next == '"' || next == '\'' || next == ')' || next == ']') {
-                    i++;
-                    current_chunk += String::chr(next);
-                } else {
-                    break;
-                }
+// Main thread: release finished pool tasks and retry throttled work
+void TextToSpeech::update_pool_tasks() {
+    std::vector<int64_t> finished;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (!pool_mode) return;
+
+        for (size_t i = 0; i < pool_task_ids.size();) {
+            if (WorkerThreadPool::get_singleton()->is_task_completed(pool_task_ids[i])) {
+                finished.push_back(pool_task_ids[i]);
+                pool_task_ids[i] = pool_task_ids.back();
+                pool_task_ids.pop_back();
+            } else {
+                i++;
             }
+        }
 
-            // Trim and add chunk if not empty
-            String trimmed = current_chunk.strip_edges();
-            if (!trimmed.is_empty()) {
-                chunks.push_back(trimmed);
-            }
-            current_chunk = "";
-            in_sentence = false;
-        } else if (c != ' ' && c != '\t' && c != '\n') {
-            in_sentence = true;
+        if (pool_retry_msec != 0 && get_steady_msec() >= pool_retry_msec && thread_running.load()) {
+            pool_retry_msec = 0;
+            dispatch_pool_tasks_locked();
         }
     }
 
-    // Add remaining text as final chunk
-    String trimmed = current_chunk.strip_edges();
-    if (!trimmed.is_empty()) {
-        chunks.push_back(trimmed);
+    // Completed tasks still have to be waited on to be freed; this does not block
+    for (int64_t task_id : finished) {
+        WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
     }
+}
 
-    // If no chunks created (text without punctuation), split by word count
-    if (chunks.is_empty() && !text.strip_edges().is_empty()) {
-        chunks.push_back(text.strip_edges());
+// Generate one job popped by take_work_locked() and publish its result
+void TextToSpeech::run_job(int slot_index, TTSJobType type, const TTSChunk &chunk, const TTSRequest &request) {
+    // Queue wait covers lookahead throttling and waiting for a free worker
+    bool is_request = type == TTS_JOB_REQUEST;
+    uint64_t trace_id = is_request ? request.request_id : chunk.request_id;
+    int trace_chunk = is_request ? -1 : chunk.chunk_index;
+    int64_t queued_usec = is_request ? request.queued_usec : chunk.queued_usec;
+    if (queued_usec > 0) {
+        tracer.add_wait("queue_wait", queued_usec, TTSTracer::now_usec(), trace_id, trace_chunk);
     }
+    TTSTraceScope trace(tracer, type == TTS_JOB_RENDER ? "render_chunk" : (is_request ? "request" : "stream_chunk"),
+            trace_id, trace_chunk);
+
+    if (type == TTS_JOB_RENDER) {
+        render_chunk(slot_index, chunk);
+    } else if (type == TTS_JOB_CHUNK) {
+        // Generate audio for chunk
+        TTSChunkResult result;
+        result.request_id = chunk.request_id;
+        result.chunk_index = chunk.chunk_index;
+        result.total_chunks = chunk.total_chunks;
+        result.audio = generate_audio_internal(chunk.text, chunk.speaker_id, chunk.speed, slot_index,
+                chunk.request_id, chunk.chunk_index);
+        result.success = result.audio.is_valid();
+
+        if (!result.success) {
+            result.error_message = "Failed to generate chunk audio";
+        }
 
-    return chunks;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            finish_chunk_locked(result);
+        }
+
+        // Store chunk result for main thread
+        result.ready_usec = tracer.timestamp();
+        {
+            std::lock_guard<std::mutex> lock(result_mutex);
+            chunk_result_queue.push_back(result);
+        }
+    } else {
+        // Generate audio for regular request
+        TTSResult result;
+        result.request_id = request.request_id;
+        result.audio = generate_audio_internal(request.text, request.speaker_id, request.speed, slot_index,
+                request.request_id);
+        result.success = result.audio.is_valid();
+
+        if (!result.success) {
+            result.error_message = "Failed to generate audio";
+        }
+
+        // Collect every request that attached while this one was queued or running
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            auto it = active_requests.find(request.request_id);
+            if (it != active_requests.end()) {
+                result.coalesced_ids.swap(it->second.coalesced_ids);
+                active_requests.erase(it);
+            }
+        }
+
+        // Store result for main thread
+        result.ready_usec = tracer.timestamp();
+        {
+            std::lock_guard<std::mutex> lock(result_mutex);
+            result_queue.push_back(result);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        generations_in_progress--;
+    }
+}
+
+void TextToSpeech::process_pending_results() {
+    // Take ownership of the pending results and emit without holding the lock,
+    // so signal handlers can queue new work without stalling the worker
+    std::deque<TTSResult> results;
+    std::deque<TTSChunkResult> chunk_results;
+    std::deque<TTSRenderEvent> render_events;
+    int64_t process_start = tracer.timestamp();
+    {
+        std::lock_guard<std::mutex> lock(result_mutex);
+        std::swap(results, result_queue);
+        std::swap(chunk_results, chunk_result_queue);
+        std::swap(render_events, render_event_queue);
+    }
+    bool delivered = !results.empty() || !chunk_results.empty() || !render_events.empty();
+
+    // Process regular results
+    while (!results.empty()) {
+        TTSResult result = results.front();
+        results.pop_front();
+
+        // Delivery wait shows a main thread that is slow to call _process
+        if (result.ready_usec > 0) {
+            tracer.add_wait("delivery_wait", result.ready_usec, TTSTracer::now_usec(), result.request_id);
+        }
+
+        // Fan the single result out to every coalesced request
+        for (size_t i = 0; i <= result.coalesced_ids.size(); i++) {
+            uint64_t id = (i == 0) ? result.request_id : result.coalesced_ids[i - 1];
+            if (result.success) {
+                emit_signal("generation_completed", id, result.audio);
+                emit_signal("speech_generated", result.audio);  // Backwards compatibility
+            } else {
+                emit_signal("generation_failed", id, result.error_message);
+            }
+        }
+    }
+
+    // Put chunk results in delivery order through each stream's reorder buffer
+    std::vector<TTSChunkResult> ordered;
+    std::vector<bool> completes_stream;
+    {
+        std::lock_guard<std::mutex> lock(stream_mutex);
+        for (const TTSChunkResult &result : chunk_results) {
+            auto it = streams.find(result.request_id);
+            if (it == streams.end()) {
+                // Stream was cancelled: deliver what was still in flight as-is
+                ordered.push_back(result);
+                completes_stream.push_back(false);
+                continue;
+            }
+
+            TTSStreamState &state = it->second;
+            state.pending_chunks[result.chunk_index] = result;
+            while (!state.pending_chunks.empty() && state.pending_chunks.begin()->first == state.next_chunk_index) {
+                const TTSChunkResult &next = state.pending_chunks.begin()->second;
+                state.next_chunk_index++;
+
+                // Fed streams only complete once end_stream() fixed the chunk count;
+                // like speak_streaming(), a stream whose last chunk failed does not complete
+                bool last = state.next_chunk_index == state.total_chunks;
+                state.last_delivered_failed = !next.success;
+                ordered.push_back(next);
+
+                // Fed-stream chunks were queued with -1; once end_stream() fixed
+                // the count, report it so listeners can spot the last chunk
+                if (state.total_chunks >= 0) {
+                    ordered.back().total_chunks = state.total_chunks;
+                }
+                completes_stream.push_back(last && next.success);
+                state.pending_chunks.erase(state.pending_chunks.begin());
+            }
+
+            if (state.total_chunks >= 0 && state.next_chunk_index >= state.total_chunks) {
+                streams.erase(it);
+            }
+        }
+    }
+
+    // Process chunk results for streaming
+    for (size_t i = 0; i < ordered.size(); i++) {
+        const TTSChunkResult &result = ordered[i];
+
+        // Includes time held back in the reorder buffer
+        if (result.ready_usec > 0) {
+            tracer.add_wait("delivery_wait", result.ready_usec, TTSTracer::now_usec(), result.request_id, result.chunk_index);
+        }
+
+        if (result.success) {
+            emit_signal("chunk_ready", result.request_id, result.chunk_index,
+                        result.total_chunks, result.audio);
+        } else {
+            emit_signal("generation_failed", result.request_id, result.error_message);
+        }
+
+        if (completes_stream[i]) {
+            emit_signal("stream_completed", result.request_id);
+        }
+    }
+
+    for (const TTSRenderEvent &event : render_events) {
+        if (event.ready_usec > 0) {
+            tracer.add_wait("delivery_wait", event.ready_usec, TTSTracer::now_usec(), event.request_id, event.chunks_done - 1);
+        }
+        if (event.success) {
+            emit_signal("render_progress", event.request_id, event.chunks_done, event.total_chunks);
+            if (event.finished) {
+                emit_signal("render_completed", event.request_id, event.path);
+            }
+        } else {
+            emit_signal("generation_failed", event.request_id, event.error_message);
+        }
+    }
+
+    // Covers the game's signal handlers, which run inside these emits
+    if (process_start > 0 && delivered) {
+        tracer.add_span("process_results", process_start, TTSTracer::now_usec());
+    }
+}
+
+void TextToSpeech::_process(double delta) {
+    // Check for completed async results and emit signals on main thread
+    process_pending_results();
+
+    update_pool_tasks();
+
+    check_idle_unload();
+}
+
+bool TextToSpeech::is_generating() const {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    return generations_in_progress > 0 || !request_queue.empty() || !chunk_queue.empty() || !renders.empty();
+}
+
+// Approximate heap footprint of a queued/returned string (UTF-32 storage)
+static int64_t get_string_bytes(const String &text) {
+    return static_cast<int64_t>(text.length()) * static_cast<int64_t>(sizeof(char32_t));
+}
+
+static int64_t get_audio_bytes(const Ref<AudioStreamWAV> &audio) {
+    return audio.is_valid() ? audio->get_data().size() : 0;
+}
+
+Dictionary TextToSpeech::get_memory_usage() const {
+    // Model size is estimated from the on-disk size of the model files and
+    // data directories; the ONNX Runtime arena is not observable through the
+    // sherpa-onnx C API
+    int64_t model_bytes = static_cast<int64_t>(model_file_bytes.load()) * resident_engines.load();
+
+    int64_t queue_bytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        for (const TTSRequest &request : request_queue) {
+            queue_bytes += sizeof(TTSRequest) + get_string_bytes(request.text);
+        }
+        for (const TTSChunk &chunk : chunk_queue) {
+            queue_bytes += sizeof(TTSChunk) + get_string_bytes(chunk.text);
+        }
+        for (const auto &entry : renders) {
+            queue_bytes += sizeof(TTSRenderJob);
+            for (int i = entry.second.next_chunk; i < entry.second.chunks.size(); i++) {
+                queue_bytes += get_string_bytes(entry.second.chunks[i]);
+            }
+        }
+    }
+
+    // Audio waiting to be picked up by _process or held for in-order delivery,
+    // plus the reusable PCM buffers
+    int64_t audio_bytes = static_cast<int64_t>(pcm_buffer_bytes.load());
+    {
+        std::lock_guard<std::mutex> lock(stream_mutex);
+        for (const auto &entry : streams) {
+            queue_bytes += sizeof(TTSStreamState) + get_string_bytes(entry.second.buffer);
+            for (const auto &pending : entry.second.pending_chunks) {
+                audio_bytes += get_audio_bytes(pending.second.audio);
+            }
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(result_mutex);
+        for (const TTSResult &result : result_queue) {
+            audio_bytes += get_audio_bytes(result.audio);
+        }
+        for (const TTSChunkResult &result : chunk_result_queue) {
+            audio_bytes += get_audio_bytes(result.audio);
+        }
+    }
+
+    Dictionary usage;
+    usage["model"] = model_bytes;
+    usage["queue"] = queue_bytes;
+    usage["cached_audio"] = audio_bytes;
+    usage["total"] = model_bytes + queue_bytes + audio_bytes;
+    return usage;
+}
+
+void TextToSpeech::cancel_generation() {
+    // Clear pending requests
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        request_queue.clear();
+        chunk_queue.clear();
+
+        // Keep lookahead accounting only for chunks still running
+        for (auto it = stream_schedule.begin(); it != stream_schedule.end();) {
+            if (it->second.in_flight <= 0) {
+                it = stream_schedule.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    // Streams are dropped: chunks still in flight are delivered as they finish,
+    // and open fed streams reject further feed_text() calls
+    {
+        std::lock_guard<std::mutex> lock(stream_mutex);
+        streams.clear();
+    }
+    // Renders stop after their current chunk and remove their partial file
+    std::vector<uint64_t> render_ids;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        for (const auto &entry : renders) {
+            render_ids.push_back(entry.first);
+        }
+    }
+    for (uint64_t id : render_ids) {
+        cancel_render(id);
+    }
+    // Note: Cannot cancel in-progress generation without modifying sherpa-onnx
+}
+
+// Sentence segmenter shared by split_into_chunks() and fed streams.
+// Appends every complete sentence in `text` to `chunks` and returns how many
+// characters were consumed. A sentence ends at . ! ? plus any closing quotes
+// or brackets; without `flush` it is only complete once a following character
+// has arrived, since more closers may still be on the way.
+static int64_t consume_sentences(const String &text, bool flush, PackedStringArray &chunks) {
+    int64_t length = text.length();
+    int64_t start = 0;
+
+    for (int64_t i = 0; i < length; i++) {
+        char32_t c = text[i];
+
+        // Check for sentence-ending punctuation
+        if (c != '.' && c != '!' && c != '?') {
+            continue;
+        }
+
+        // Look ahead for closing quotes or parentheses
+        int64_t end = i;
+        while (end + 1 < length) {
+            char32_t next = text[end + 1];
+            if (next == '"' || next == '\'' || next == ')' || next == ']') {
+                end++;
+            } else {
+                break;
+            }
+        }
+
+        if (!flush && end + 1 >= length) {
+            break;
+        }
+
+        // Trim and add chunk if not empty
+        String trimmed = text.substr(start, end + 1 - start).strip_edges();
+        if (!trimmed.is_empty()) {
+            chunks.push_back(trimmed);
+        }
+        start = end + 1;
+        i = end;
+    }
+
+    if (flush) {
+        // Add remaining text (or text without punctuation) as final chunk
+        String trimmed = text.substr(start).strip_edges();
+        if (!trimmed.is_empty()) {
+            chunks.push_back(trimmed);
+        }
+        return length;
+    }
+
+    return start;
+}
+
+// Split text into chunks for streaming TTS
+PackedStringArray TextToSpeech::split_into_chunks(const String &text) {
+    PackedStringArray chunks;
+
+    if (text.is_empty()) {
+        return chunks;
+    }
+
+    consume_sentences(text, true, chunks);
+    return chunks;
+}
+
+// Adaptive chunking limits: the opening clause must be long enough to sound
+// natural, and merged chunks stay well inside Kokoro's ~510 token context
+static const int64_t FIRST_CLAUSE_MIN_CHARS = 12;
+static const int64_t FIRST_CHUNK_MAX_CHARS = 60;
+static const int64_t ADAPTIVE_CHUNK_MAX_CHARS = 400;
+
+// Split a long opening sentence at its first clause boundary (, ; : or a dash)
+static bool split_first_clause(const String &sentence, String &clause, String &rest) {
+    int64_t length = sentence.length();
+    if (length <= FIRST_CHUNK_MAX_CHARS) {
+        return false;
+    }
+
+    for (int64_t i = FIRST_CLAUSE_MIN_CHARS; i < length - FIRST_CLAUSE_MIN_CHARS; i++) {
+        char32_t c = sentence[i];
+        bool boundary = (c == ',' || c == ';' || c == ':') ? sentence[i + 1] == ' ' : (c == U'\u2014' || c == U'\u2013');
+        if (boundary) {
+            clause = sentence.substr(0, i + 1).strip_edges();
+            rest = sentence.substr(i + 1).strip_edges();
+            return true;
+        }
+    }
+    return false;
+}
+
+// Re-chunk sentences for streaming: the first chunk is a single clause for the
+// fastest start, and later sentences are merged into larger chunks whenever a
+// simulated playback buffer stays above `margin` seconds. The simulation
+// assumes one worker synthesizing chunks back to back at `rtf`; with no
+// measurement yet (rtf <= 0) sentences are left unmerged.
+static PackedStringArray plan_adaptive_chunks(const PackedStringArray &sentences, float rtf, float seconds_per_char, float margin) {
+    PackedStringArray chunks;
+    if (sentences.is_empty()) {
+        return chunks;
+    }
+
+    PackedStringArray pending;
+    String clause;
+    String rest;
+    if (split_first_clause(sentences[0], clause, rest)) {
+        chunks.push_back(clause);
+        pending.push_back(rest);
+    } else {
+        chunks.push_back(sentences[0]);
+    }
+    for (int64_t i = 1; i < sentences.size(); i++) {
+        pending.push_back(sentences[i]);
+    }
+
+    if (rtf <= 0.0f || seconds_per_char <= 0.0f) {
+        for (int64_t i = 0; i < pending.size(); i++) {
+            chunks.push_back(pending[i]);
+        }
+        return chunks;
+    }
+
+    // Times in seconds from the request: when the previous chunk is ready,
+    // and when the audio buffered so far runs out
+    float ready = rtf * chunks[0].length() * seconds_per_char;
+    float play_end = ready + chunks[0].length() * seconds_per_char;
+
+    int64_t next = 0;
+    while (next < pending.size()) {
+        String chunk = pending[next++];
+        float chunk_ready = ready + rtf * chunk.length() * seconds_per_char;
+
+        while (next < pending.size()) {
+            String merged = chunk + " " + pending[next];
+            float merged_ready = ready + rtf * merged.length() * seconds_per_char;
+            if (merged.length() > ADAPTIVE_CHUNK_MAX_CHARS || play_end - merged_ready < margin) {
+                break;
+            }
+            chunk = merged;
+            chunk_ready = merged_ready;
+            next++;
+        }
+
+        chunks.push_back(chunk);
+        ready = chunk_ready;
+        play_end = std::max(play_end, ready) + chunk.length() * seconds_per_char;
+    }
+
+    return chunks;
 }
 
 // Streaming speech generation (low-latency chunked)
 uint64_t TextToSpeech::speak_streaming(const String &text) {
-    if (!tts) {
+    if (!is_model_loaded()) {
         UtilityFunctions::printerr("TextToSpeech: Model not loaded");
         return 0;
     }
@@ -578,8 +1622,21 @@ uint64_t TextToSpeech::speak_streaming(const String &text) {
         return 0;
     }
 
+    int sid = speaker_id.load();
+    float spd = speed.load();
+
     // Split text into chunks
     PackedStringArray chunks = split_into_chunks(text);
+    if (adaptive_chunking.load()) {
+        float rtf;
+        float seconds_per_char;
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex);
+            rtf = measured_rtf;
+            seconds_per_char = measured_seconds_per_char;
+        }
+        chunks = plan_adaptive_chunks(chunks, rtf, seconds_per_char / spd, adaptive_chunk_margin.load());
+    }
 
     if (chunks.is_empty()) {
         UtilityFunctions::printerr("TextToSpeech: No chunks created from text");
@@ -587,28 +1644,36 @@ uint64_t TextToSpeech::speak_streaming(const String &text) {
     }
 
     // Start worker thread if not running
-    if (!thread_running.load()) {
-        start_worker_thread();
-    }
+    start_worker_thread();
 
     uint64_t request_id = next_request_id.fetch_add(1);
     int total_chunks = chunks.size();
 
+    // Register the stream before any chunk can finish
+    TTSStreamState state;
+    state.total_chunks = total_chunks;
+    {
+        std::lock_guard<std::mutex> lock(stream_mutex);
+        streams[request_id] = state;
+    }
+
     // Queue all chunks for generation
+    int64_t queued_usec = tracer.timestamp();
     {
         std::lock_guard<std::mutex> lock(queue_mutex);
         for (int i = 0; i < total_chunks; i++) {
             TTSChunk chunk;
             chunk.text = chunks[i];
-            chunk.speaker_id = speaker_id;
-            chunk.speed = speed;
+            chunk.speaker_id = sid;
+            chunk.speed = spd;
             chunk.request_id = request_id;
             chunk.chunk_index = i;
             chunk.total_chunks = total_chunks;
             chunk.is_streaming = true;
-            chunk_queue.push(chunk);
+            chunk.queued_usec = queued_usec;
+            chunk_queue.push_back(chunk);
         }
-        work_condition.notify_one();
+        notify_work_locked();
     }
 
     // Emit signal using call_deferred for thread safety
@@ -625,6 +1690,218 @@ uint64_t TextToSpeech::speak_streaming(const String &text) {
     return request_id;
 }
 
+// Incremental streaming: open a stream that accepts text via feed_text()
+uint64_t TextToSpeech::begin_stream() {
+    if (!is_model_loaded()) {
+        UtilityFunctions::printerr("TextToSpeech: Model not loaded");
+        return 0;
+    }
+
+    // Start worker thread if not running
+    start_worker_thread();
+
+    uint64_t stream_id = next_request_id.fetch_add(1);
+
+    TTSStreamState stream;
+    stream.fed = true;
+    stream.speaker_id = speaker_id.load();
+    stream.speed = speed.load();
+    {
+        std::lock_guard<std::mutex> lock(stream_mutex);
+        streams[stream_id] = stream;
+    }
+
+    // Emit signal using call_deferred for thread safety
+    call_deferred("emit_signal", "generation_started", stream_id);
+
+    if (debug_mode) {
+        UtilityFunctions::print("TextToSpeech: Opened fed stream #", stream_id);
+    }
+
+    return stream_id;
+}
+
+// Append text to an open stream; every sentence it completes is queued at once
+bool TextToSpeech::feed_text(uint64_t stream_id, const String &fragment) {
+    std::lock_guard<std::mutex> lock(stream_mutex);
+
+    auto it = streams.find(stream_id);
+    if (it == streams.end() || !it->second.fed || it->second.total_chunks >= 0) {
+        UtilityFunctions::printerr("TextToSpeech: Stream #", stream_id, " is not open");
+        return false;
+    }
+
+    it->second.buffer += fragment;
+    queue_fed_chunks(stream_id, it->second, false);
+    return true;
+}
+
+// Close a stream: the remaining text becomes the final chunk
+bool TextToSpeech::end_stream(uint64_t stream_id) {
+    bool completed = false;
+    {
+        std::lock_guard<std::mutex> lock(stream_mutex);
+
+        auto it = streams.find(stream_id);
+        if (it == streams.end() || !it->second.fed || it->second.total_chunks >= 0) {
+            UtilityFunctions::printerr("TextToSpeech: Stream #", stream_id, " is not open");
+            return false;
+        }
+
+        TTSStreamState &stream = it->second;
+        queue_fed_chunks(stream_id, stream, true);
+        stream.total_chunks = stream.chunks_queued;
+
+        // Everything may already have been delivered (or nothing was fed)
+        if (stream.next_chunk_index == stream.total_chunks) {
+            completed = !stream.last_delivered_failed;
+            streams.erase(it);
+        }
+    }
+
+    if (completed) {
+        call_deferred("emit_signal", "stream_completed", stream_id);
+    }
+    return true;
+}
+
+// Segment the stream buffer and queue complete sentences (caller holds stream_mutex)
+void TextToSpeech::queue_fed_chunks(uint64_t stream_id, TTSStreamState &stream, bool flush) {
+    PackedStringArray sentences;
+    int64_t consumed = consume_sentences(stream.buffer, flush, sentences);
+    if (consumed > 0) {
+        stream.buffer = stream.buffer.substr(consumed);
+    }
+    if (sentences.is_empty()) {
+        return;
+    }
+
+    int64_t queued_usec = tracer.timestamp();
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        for (int i = 0; i < sentences.size(); i++) {
+            TTSChunk chunk;
+            chunk.text = sentences[i];
+            chunk.speaker_id = stream.speaker_id;
+            chunk.speed = stream.speed;
+            chunk.request_id = stream_id;
+            chunk.chunk_index = stream.chunks_queued++;
+            chunk.total_chunks = -1;  // Unknown until end_stream()
+            chunk.is_streaming = true;
+            chunk.queued_usec = queued_usec;
+            chunk_queue.push_back(chunk);
+        }
+        notify_work_locked();
+    }
+
+    if (debug_mode) {
+        for (int i = 0; i < sentences.size(); i++) {
+            UtilityFunctions::print("TextToSpeech: Stream #", stream_id, " queued chunk: ", sentences[i]);
+        }
+    }
+}
+
+// Render long text to a WAV file in the background. Chunks are synthesized in
+// order and appended as they finish; render_progress fires after each one and
+// render_completed once the file is closed
+uint64_t TextToSpeech::render_to_file(const String &text, const String &path, const String &format) {
+    if (!is_model_loaded()) {
+        UtilityFunctions::printerr("TextToSpeech: Model not loaded");
+        return 0;
+    }
+
+    if (text.is_empty()) {
+        UtilityFunctions::printerr("TextToSpeech: Empty text");
+        return 0;
+    }
+
+    // Godot exposes no Vorbis encoder to extensions, so only WAV is written;
+    // convert offline if Ogg is needed
+    String file_format = format.to_lower();
+    if (file_format != "wav") {
+        UtilityFunctions::printerr("TextToSpeech: Unsupported render format '", format, "' (only \"wav\" is supported)");
+        return 0;
+    }
+
+    PackedStringArray chunks = split_into_chunks(text);
+    if (chunks.is_empty()) {
+        UtilityFunctions::printerr("TextToSpeech: No chunks created from text");
+        return 0;
+    }
+
+    TTSRenderJob job;
+    job.path = resolve_path(path);
+    job.file = FileAccess::open(job.path, FileAccess::WRITE);
+    if (job.file.is_null()) {
+        UtilityFunctions::printerr("TextToSpeech: Cannot open ", path, " for writing");
+        return 0;
+    }
+
+    // Placeholder; sizes and the rate the engine actually produced are
+    // patched in once the last chunk is written
+    write_wav_header(job.file, get_sample_rate(), 0);
+
+    job.chunks = chunks;
+    job.speaker_id = speaker_id.load();
+    job.speed = speed.load();
+    job.queued_usec = tracer.timestamp();
+
+    // Start worker thread if not running
+    start_worker_thread();
+
+    uint64_t request_id = next_request_id.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        renders[request_id] = job;
+        notify_work_locked();
+    }
+
+    // Emit signal using call_deferred for thread safety
+    call_deferred("emit_signal", "generation_started", request_id);
+
+    if (debug_mode) {
+        UtilityFunctions::print("TextToSpeech: Queued render #", request_id, " with ", chunks.size(),
+            " chunks to ", job.path);
+    }
+
+    return request_id;
+}
+
+// Stop a render after its current chunk; the partial file is deleted
+bool TextToSpeech::cancel_render(uint64_t request_id) {
+    TTSRenderJob job;
+    TTSRenderEvent event;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        auto it = renders.find(request_id);
+        if (it == renders.end() || it->second.cancelled) {
+            return false;
+        }
+
+        // A running chunk finishes first, then its worker closes the file
+        it->second.cancelled = true;
+        if (it->second.running) {
+            return true;
+        }
+
+        job = it->second;
+        renders.erase(it);
+    }
+
+    event.request_id = request_id;
+    event.chunks_done = job.next_chunk;
+    event.total_chunks = job.chunks.size();
+    event.finished = true;
+    event.success = false;
+    event.error_message = "Render cancelled";
+    finish_render(job, event);
+    event.ready_usec = tracer.timestamp();
+
+    std::lock_guard<std::mutex> lock(result_mutex);
+    render_event_queue.push_back(event);
+    return true;
+}
+
 void TextToSpeech::set_speaker_id(int id) {
     speaker_id = id;
 }
@@ -642,13 +1919,11 @@ float TextToSpeech::get_speed() const {
 }
 
 int TextToSpeech::get_speaker_count() const {
-    if (!tts) return 0;
-    return SherpaOnnxOfflineTtsNumSpeakers(tts);
+    return cached_speaker_count.load();
 }
 
 int TextToSpeech::get_sample_rate() const {
-    if (!tts) return 0;
-    return SherpaOnnxOfflineTtsSampleRate(tts);
+    return cached_sample_rate.load();
 }
 
 // Performance property setters/getters
@@ -668,6 +1943,91 @@ bool TextToSpeech::get_debug_mode() const {
     return debug_mode;
 }
 
+void TextToSpeech::set_coalesce_requests(bool enabled) {
+    coalesce_requests = enabled;
+}
+
+bool TextToSpeech::get_coalesce_requests() const {
+    return coalesce_requests;
+}
+
+void TextToSpeech::set_parallel_workers(int count) {
+    parallel_workers = std::max(1, std::min(count, static_cast<int>(MAX_PARALLEL_WORKERS)));
+}
+
+int TextToSpeech::get_parallel_workers() const {
+    return parallel_workers;
+}
+
+void TextToSpeech::set_stream_lookahead(float seconds) {
+    stream_lookahead = seconds;
+    // Throttled workers re-evaluate against the new limit
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    work_condition.notify_all();
+    if (pool_mode && thread_running.load()) {
+        dispatch_pool_tasks_locked();
+    }
+}
+
+float TextToSpeech::get_stream_lookahead() const {
+    return stream_lookahead;
+}
+
+void TextToSpeech::set_use_worker_thread_pool(bool enabled) {
+    use_worker_thread_pool = enabled;
+}
+
+bool TextToSpeech::get_use_worker_thread_pool() const {
+    return use_worker_thread_pool;
+}
+
+void TextToSpeech::set_adaptive_chunking(bool enabled) {
+    adaptive_chunking = enabled;
+}
+
+bool TextToSpeech::get_adaptive_chunking() const {
+    return adaptive_chunking;
+}
+
+void TextToSpeech::set_adaptive_chunk_margin(float seconds) {
+    adaptive_chunk_margin = std::max(0.0f, seconds);
+}
+
+float TextToSpeech::get_adaptive_chunk_margin() const {
+    return adaptive_chunk_margin;
+}
+
+float TextToSpeech::get_measured_real_time_factor() const {
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    return measured_rtf;
+}
+
+void TextToSpeech::set_trace_enabled(bool enabled) {
+    if (enabled) {
+        // Usually toggled from the main thread; workers name themselves
+        tracer.name_current_thread("Main thread");
+    }
+    tracer.set_enabled(enabled);
+}
+
+bool TextToSpeech::get_trace_enabled() const {
+    return tracer.is_enabled();
+}
+
+// Write the recorded spans as Chrome trace JSON (open in ui.perfetto.dev)
+bool TextToSpeech::export_trace(const String &path) {
+    if (!tracer.export_json(path)) {
+        UtilityFunctions::printerr("TextToSpeech: Cannot write trace to ", path);
+        return false;
+    }
+    UtilityFunctions::print("TextToSpeech: Trace written to ", path);
+    return true;
+}
+
+void TextToSpeech::clear_trace() {
+    tracer.clear();
+}
+
 void TextToSpeech::set_max_sentences(int count) {
     max_sentences = count;
 }
@@ -675,3 +2035,36 @@ void TextToSpeech::set_max_sentences(int count) {
 int TextToSpeech::get_max_sentences() const {
     return max_sentences;
 }
+
+void TextToSpeech::set_idle_unload_timeout(float seconds) {
+    idle_unload_timeout = seconds;
+    touch_activity();
+}
+
+float TextToSpeech::get_idle_unload_timeout() const {
+    return idle_unload_timeout;
+}
+
+void TextToSpeech::set_backend(Backend type) {
+    backend_type = type;
+}
+
+TextToSpeech::Backend TextToSpeech::get_backend() const {
+    return backend_type;
+}
+
+void TextToSpeech::set_mock_latency(float seconds) {
+    mock_latency = seconds;
+}
+
+float TextToSpeech::get_mock_latency() const {
+    return mock_latency;
+}
+
+void TextToSpeech::set_mock_real_time_factor(float factor) {
+    mock_real_time_factor = factor;
+}
+
+float TextToSpeech::get_mock_real_time_factor() const {
+    return mock_real_time_factor;
+}
@@ -3,17 +3,22 @@
 
 #include <godot_cpp/classes/node.hpp>
 #include <godot_cpp/classes/audio_stream_wav.hpp>
+#include <godot_cpp/classes/file_access.hpp>
 #include <godot_cpp/variant/string.hpp>
 #include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
 
 #include <thread>
 #include <atomic>
-#include <queue>
+#include <deque>
 #include <mutex>
 #include <condition_variable>
+#include <map>
+#include <memory>
+#include <vector>
 
-// Forward declaration - sherpa-onnx C API types
-typedef struct SherpaOnnxOfflineTts SherpaOnnxOfflineTts;
+#include "tts_backend.h"
+#include "tts_trace.h"
 
 namespace godot {
 
@@ -23,14 +28,18 @@ struct TTSRequest {
     int speaker_id;
     float speed;
     uint64_t request_id;
+    std::vector<uint64_t> coalesced_ids;  // Identical requests sharing this job
+    int64_t queued_usec = 0;              // Trace timestamp, 0 when not tracing
 };
 
 // Result structure for async TTS
 struct TTSResult {
     Ref<AudioStreamWAV> audio;
     uint64_t request_id;
+    std::vector<uint64_t> coalesced_ids;  // Also receive this result
     bool success;
     String error_message;
+    int64_t ready_usec = 0;               // Trace timestamp, 0 when not tracing
 };
 
 // Chunk structure for streaming TTS
@@ -42,6 +51,14 @@ struct TTSChunk {
     int chunk_index;
     int total_chunks;
     bool is_streaming;  // true = streaming mode, false = regular async
+    int64_t queued_usec = 0;  // Trace timestamp, 0 when not tracing
+};
+
+// Kind of work a worker took from the queues
+enum TTSJobType {
+    TTS_JOB_REQUEST,  // speak_async()
+    TTS_JOB_CHUNK,    // One chunk of a stream
+    TTS_JOB_RENDER,   // Next chunk of a render_to_file()
 };
 
 // Chunk result for streaming TTS
@@ -52,53 +69,198 @@ struct TTSChunkResult {
     int total_chunks;
     bool success;
     String error_message;
+    int64_t ready_usec = 0;  // Trace timestamp, 0 when not tracing
+};
+
+// Main-thread delivery state for a stream
+struct TTSStreamState {
+    // Reorder buffer: chunks may finish out of order on parallel workers, but
+    // chunk_ready is emitted strictly in chunk_index order
+    int next_chunk_index = 0;
+    std::map<int, TTSChunkResult> pending_chunks;
+    int total_chunks = -1;  // -1 until known (fed streams: set by end_stream)
+    bool last_delivered_failed = false;  // A failed final chunk means no stream_completed
+
+    // Fed streams only (begin_stream/feed_text/end_stream)
+    bool fed = false;
+    String buffer;          // Text received but not yet a complete sentence
+    int speaker_id = 0;
+    float speed = 1.0f;
+    int chunks_queued = 0;
+};
+
+// Worker-side scheduling state used to bound a stream's lookahead
+struct TTSStreamSchedule {
+    int in_flight = 0;
+    int chunks_done = 0;
+    float audio_seconds = 0.0f;     // Audio synthesized so far
+    int64_t first_ready_msec = 0;   // Playback is assumed to start here
+};
+
+// Long-form render: chunks are synthesized one at a time and appended to the
+// file, so memory use does not grow with the length of the text
+struct TTSRenderJob {
+    PackedStringArray chunks;
+    int next_chunk = 0;
+    int speaker_id = 0;
+    float speed = 1.0f;
+    String path;              // Absolute path of the output file
+    Ref<FileAccess> file;     // Only touched by the worker while running
+    int sample_rate = 0;      // Rate of the first chunk written, 0 before it
+    int64_t data_bytes = 0;   // PCM bytes written after the header
+    bool running = false;     // A worker is appending a chunk
+    bool cancelled = false;
+    int64_t queued_usec = 0;  // When the next chunk became ready to run (tracing)
+};
+
+// Render progress, delivered on the main thread
+struct TTSRenderEvent {
+    uint64_t request_id;
+    int chunks_done;
+    int total_chunks;
+    bool finished;
+    bool success;
+    String path;
+    String error_message;
+    int64_t ready_usec = 0;  // Trace timestamp, 0 when not tracing
+};
+
+// One synthesis engine plus its scratch buffer; worker N generates on slot N
+struct TTSEngineSlot {
+    std::mutex mutex;
+    std::unique_ptr<TTSBackend> engine;
+    PackedByteArray pcm_buffer;  // Reusable block for render_to_file() PCM conversion
 };
 
 class TextToSpeech : public Node {
     GDCLASS(TextToSpeech, Node)
 
+public:
+    enum Backend {
+        BACKEND_SHERPA,  // Kokoro via sherpa-onnx (default)
+        BACKEND_MOCK,    // Deterministic synthetic audio, no model required
+    };
+
+    static const int MAX_PARALLEL_WORKERS = 8;
+
 private:
-    const SherpaOnnxOfflineTts *tts = nullptr;
+    // Engine access: each slot's engine and PCM buffer are only touched while
+    // holding that slot's mutex, so load_model() can never destroy an engine
+    // underneath an in-flight generation. The stored paths are guarded by
+    // config_mutex. Lock order: slots in ascending index, then config_mutex.
+    TTSEngineSlot engine_slots[MAX_PARALLEL_WORKERS];
+    mutable std::mutex config_mutex;
     String model_path;
     String voices_path;
     String tokens_path;
+    String data_dir_path;
     String lexicon_path;  // For multi-lang models
     String dict_dir;      // For multi-lang models
     String lang;          // Language code (e.g., "en-us", "zh", "ja")
-    int speaker_id = 0;
-    float speed = 1.0f;
-    bool model_loaded = false;
+    std::atomic<int> speaker_id{0};
+    std::atomic<float> speed{1.0f};
+    std::atomic<bool> model_loaded{false};
+    std::atomic<int> cached_sample_rate{0};     // Snapshot taken at load time so
+    std::atomic<int> cached_speaker_count{0};   // getters never wait on the engine
+
+    // Idle unloading: model_loaded stays true while the engine itself is
+    // released, and the next generation recreates it from the stored paths
+    std::atomic<float> idle_unload_timeout{0.0f};   // seconds, 0 = never unload
+    std::atomic<int64_t> last_activity_msec{0};
+    std::atomic<int> resident_engines{0};
+    std::atomic<uint64_t> model_file_bytes{0};
 
     // Performance configuration
-    int num_threads = 0;        // 0 = auto-detect
-    bool debug_mode = false;    // Debug output disabled by default
-    int max_sentences = 2;      // Sentence batching
+    std::atomic<int> num_threads{0};        // 0 = auto-detect
+    std::atomic<bool> debug_mode{false};    // Debug output disabled by default
+    std::atomic<int> max_sentences{2};      // Sentence batching
+
+    // Backend selection (takes effect at the next load_model)
+    std::atomic<Backend> backend_type{BACKEND_SHERPA};
+    std::atomic<float> mock_latency{0.0f};
+    std::atomic<float> mock_real_time_factor{0.0f};
 
-    // Reusable buffer for PCM conversion
-    PackedByteArray pcm_buffer;
+    // Total size of the slots' PCM blocks
+    std::atomic<int64_t> pcm_buffer_bytes{0};
 
     // Threading infrastructure for async generation
-    std::thread worker_thread;
+    std::atomic<int> parallel_workers{1};       // Worker threads (and engines) used
+    std::atomic<float> stream_lookahead{10.0f}; // Seconds of audio a stream may run ahead, 0 = unlimited
+    std::atomic<bool> use_worker_thread_pool{false};  // Run jobs as WorkerThreadPool tasks
+
+    // Adaptive chunking for speak_streaming(), driven by measured synthesis speed
+    std::atomic<bool> adaptive_chunking{false};
+    std::atomic<float> adaptive_chunk_margin{0.5f};  // Seconds of buffered audio to keep
+    mutable std::mutex stats_mutex;
+    float measured_rtf = 0.0f;              // Guarded by stats_mutex, 0 = no data yet
+    float measured_seconds_per_char = 0.0f; // Guarded by stats_mutex, at speed 1.0
+    std::mutex worker_mutex;    // Serializes start/stop of worker_threads
+    std::vector<std::thread> worker_threads;
     std::atomic<bool> thread_running{false};
     std::atomic<bool> should_exit{false};
-    std::mutex queue_mutex;
-    std::mutex result_mutex;
+    mutable std::mutex queue_mutex;
+    mutable std::mutex result_mutex;
     std::condition_variable work_condition;
-    std::queue<TTSRequest> request_queue;
-    std::queue<TTSResult> result_queue;
+    std::deque<TTSRequest> request_queue;
+    std::deque<TTSResult> result_queue;
     std::atomic<uint64_t> next_request_id{1};
-    std::atomic<bool> generation_in_progress{false};
+    int generations_in_progress = 0;      // Guarded by queue_mutex
+    int worker_count = 1;                 // Guarded by queue_mutex (fixed while running)
+    bool pool_mode = false;               // Guarded by queue_mutex (fixed while running)
+
+    // WorkerThreadPool mode, all guarded by queue_mutex
+    std::vector<int64_t> pool_task_ids;   // Waited on from the main thread once done
+    int pool_tasks_running = 0;
+    bool pool_slot_in_use[MAX_PARALLEL_WORKERS] = {};
+    int64_t pool_retry_msec = 0;          // When a throttled stream may run again
+
+    // Duplicate speak_async() calls attach to a queued or running job
+    std::atomic<bool> coalesce_requests{true};
+    std::map<uint64_t, TTSRequest> active_requests;  // Guarded by queue_mutex
 
     // Streaming infrastructure
-    std::queue<TTSChunk> chunk_queue;
-    std::queue<TTSChunkResult> chunk_result_queue;
+    std::deque<TTSChunk> chunk_queue;
+    std::deque<TTSChunkResult> chunk_result_queue;
+    std::map<uint64_t, TTSStreamSchedule> stream_schedule;  // Guarded by queue_mutex
+
+    // Per-stream delivery order and fed-stream buffers
+    mutable std::mutex stream_mutex;
+    std::map<uint64_t, TTSStreamState> streams;
+
+    // Render-to-file jobs, lowest scheduling priority
+    std::map<uint64_t, TTSRenderJob> renders;        // Guarded by queue_mutex
+    std::deque<TTSRenderEvent> render_event_queue;   // Guarded by result_mutex
+
+    // Optional per-stage spans for export_trace()
+    TTSTracer tracer;
 
     // Internal methods
-    void worker_thread_func();
+    void worker_thread_func(int slot_index);
+    void pool_task_func();
+    void dispatch_pool_tasks_locked();
+    void notify_work_locked();
+    void update_pool_tasks();
+    void run_job(int slot_index, TTSJobType type, const TTSChunk &chunk, const TTSRequest &request);
+    bool take_work_locked(TTSChunk &chunk, TTSRequest &request, TTSJobType &type, int64_t &wait_msec);
+    int count_pending_jobs_locked() const;
+    void finish_chunk_locked(const TTSChunkResult &result);
     void process_pending_results();
-    Ref<AudioStreamWAV> generate_audio_internal(const String &text, int sid, float spd);
+    bool generate_with_engine(const String &text, int sid, float spd, int slot_index, uint64_t trace_id, int trace_chunk,
+            const TTSAudioSink &sink);
+    Ref<AudioStreamWAV> generate_audio_internal(const String &text, int sid, float spd, int slot_index = -1,
+            uint64_t trace_id = 0, int trace_chunk = -1);
+    void render_chunk(int slot_index, const TTSChunk &chunk);
+    void finish_render(TTSRenderJob &job, TTSRenderEvent &event);
+    void record_generation(float elapsed_seconds, float audio_seconds, int64_t characters, float spd);
     void start_worker_thread();
     void stop_worker_thread();
+    TTSBackendConfig get_engine_config() const;
+    bool create_engine(TTSEngineSlot &slot, const TTSBackendConfig &config);
+    void destroy_engine(TTSEngineSlot &slot);
+    bool ensure_engine(TTSEngineSlot &slot);
+    void touch_activity();
+    void check_idle_unload();
+    void queue_fed_chunks(uint64_t stream_id, TTSStreamState &stream, bool flush);
 
 protected:
     static void _bind_methods();
@@ -124,6 +286,21 @@ public:
     uint64_t speak_streaming(const String &text);
     static PackedStringArray split_into_chunks(const String &text);
 
+    // Incremental streaming (text arrives piece by piece, e.g. from an LLM)
+    uint64_t begin_stream();
+    bool feed_text(uint64_t stream_id, const String &fragment);
+    bool end_stream(uint64_t stream_id);
+
+    // Long-form rendering straight to disk (e.g. audiobook narration)
+    uint64_t render_to_file(const String &text, const String &path, const String &format = "wav");
+    bool cancel_render(uint64_t request_id);
+
+    // Pipeline tracing (Chrome trace / Perfetto JSON)
+    void set_trace_enabled(bool enabled);
+    bool get_trace_enabled() const;
+    bool export_trace(const String &path = "user://tts_trace.json");
+    void clear_trace();
+
     // Called each frame to check for completed async generations
     void _process(double delta);
 
@@ -138,9 +315,36 @@ public:
     int get_num_threads() const;
     void set_debug_mode(bool enabled);
     bool get_debug_mode() const;
+    void set_coalesce_requests(bool enabled);
+    bool get_coalesce_requests() const;
+    void set_parallel_workers(int count);
+    int get_parallel_workers() const;
+    void set_stream_lookahead(float seconds);
+    float get_stream_lookahead() const;
+    void set_use_worker_thread_pool(bool enabled);
+    bool get_use_worker_thread_pool() const;
+    void set_adaptive_chunking(bool enabled);
+    bool get_adaptive_chunking() const;
+    void set_adaptive_chunk_margin(float seconds);
+    float get_adaptive_chunk_margin() const;
+    float get_measured_real_time_factor() const;
     void set_max_sentences(int count);
     int get_max_sentences() const;
 
+    // Properties - memory
+    void set_idle_unload_timeout(float seconds);
+    float get_idle_unload_timeout() const;
+    bool is_engine_resident() const;
+    Dictionary get_memory_usage() const;
+
+    // Properties - backend
+    void set_backend(Backend type);
+    Backend get_backend() const;
+    void set_mock_latency(float seconds);
+    float get_mock_latency() const;
+    void set_mock_real_time_factor(float factor);
+    float get_mock_real_time_factor() const;
+
     // Utility
     int get_speaker_count() const;
     int get_sample_rate() const;
@@ -149,4 +353,6 @@ public:
 
 } // namespace godot
 
+VARIANT_ENUM_CAST(godot::TextToSpeech::Backend);
+
 #endif // TEXT_TO_SPEECH_H
@@ -0,0 +1,46 @@
+#ifndef TTS_BACKEND_H
+#define TTS_BACKEND_H
+
+#include <godot_cpp/variant/string.hpp>
+
+#include <cstdint>
+#include <functional>
+
+namespace godot {
+
+// Everything a backend needs to create its engine
+struct TTSBackendConfig {
+    String model_path;
+    String voices_path;
+    String tokens_path;
+    String data_dir;
+    String lexicon_path;  // For multi-lang models
+    String dict_dir;      // For multi-lang models
+    String lang;          // Language code (e.g., "en-us", "zh", "ja")
+    int num_threads = 1;
+    bool debug = false;
+    int max_sentences = 2;
+};
+
+// Receives generated mono float audio; `samples` is only valid during the call
+typedef std::function<void(const float *samples, int32_t count, int32_t sample_rate)> TTSAudioSink;
+
+// Synthesis engine used by TextToSpeech. Implementations are not required to
+// be thread-safe: TextToSpeech serializes every call on its engine mutex.
+class TTSBackend {
+public:
+    virtual ~TTSBackend() {}
+
+    // Create the engine; returns false if it could not be loaded
+    virtual bool create(const TTSBackendConfig &config) = 0;
+
+    // Synthesize `text`; calls `sink` once with the audio and returns true on success
+    virtual bool generate(const String &text, int speaker_id, float speed, const TTSAudioSink &sink) = 0;
+
+    virtual int get_sample_rate() const = 0;
+    virtual int get_speaker_count() const = 0;
+};
+
+} // namespace godot
+
+#endif // TTS_BACKEND_H
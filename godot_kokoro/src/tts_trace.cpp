@@ -0,0 +1,174 @@
+#include "tts_trace.h"
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+using namespace godot;
+
+int64_t TTSTracer::now_usec() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Small sequential ids read better in trace viewers than native thread ids
+int TTSTracer::current_thread_id() {
+    static std::atomic<int> next_thread_id{1};
+    thread_local int thread_id = next_thread_id.fetch_add(1);
+    return thread_id;
+}
+
+void TTSTracer::set_enabled(bool p_enabled) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (p_enabled && events.empty()) {
+        events.resize(CAPACITY);
+    }
+    enabled.store(p_enabled);
+}
+
+void TTSTracer::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    next_event = 0;
+    wrapped = false;
+}
+
+void TTSTracer::name_current_thread(const String &name) {
+    int thread_id = current_thread_id();
+    std::lock_guard<std::mutex> lock(mutex);
+    thread_names[thread_id] = name;
+}
+
+void TTSTracer::add_event(const char *name, int64_t start_usec, int64_t end_usec, uint64_t request_id, int chunk_index, bool is_wait) {
+    if (!is_enabled() || start_usec <= 0) return;
+
+    TTSTraceEvent event;
+    event.name = name;
+    event.start_usec = start_usec;
+    event.duration_usec = end_usec > start_usec ? end_usec - start_usec : 0;
+    event.thread_id = current_thread_id();
+    event.request_id = request_id;
+    event.chunk_index = chunk_index;
+    event.is_wait = is_wait;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (events.empty()) return;
+    events[next_event] = event;
+    next_event++;
+    if (next_event == events.size()) {
+        next_event = 0;
+        wrapped = true;
+    }
+}
+
+void TTSTracer::add_span(const char *name, int64_t start_usec, int64_t end_usec, uint64_t request_id, int chunk_index) {
+    add_event(name, start_usec, end_usec, request_id, chunk_index, false);
+}
+
+void TTSTracer::add_wait(const char *name, int64_t start_usec, int64_t end_usec, uint64_t request_id, int chunk_index) {
+    add_event(name, start_usec, end_usec, request_id, chunk_index, true);
+}
+
+static void append_json_string(std::string &json, const CharString &text) {
+    json += '"';
+    for (const char *c = text.get_data(); *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            json += '\\';
+        }
+        if (static_cast<unsigned char>(*c) >= 0x20) {
+            json += *c;
+        }
+    }
+    json += '"';
+}
+
+bool TTSTracer::export_json(const String &path) const {
+    // Copy out under the lock and format without it, so recording threads
+    // are only held up for the copy
+    std::vector<TTSTraceEvent> snapshot;
+    std::map<int, String> names;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (wrapped) {
+            snapshot.assign(events.begin() + next_event, events.end());
+        }
+        snapshot.insert(snapshot.end(), events.begin(), events.begin() + next_event);
+        names = thread_names;
+    }
+
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    char line[512];
+    bool first = true;
+
+    for (const auto &entry : names) {
+        snprintf(line, sizeof(line), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":",
+                first ? "" : ",\n", entry.first);
+        json += line;
+        append_json_string(json, entry.second.utf8());
+        json += "}}";
+        first = false;
+    }
+
+    int64_t origin = snapshot.empty() ? 0 : snapshot.front().start_usec;
+    for (const TTSTraceEvent &event : snapshot) {
+        origin = std::min(origin, event.start_usec);
+    }
+
+    uint64_t wait_id = 0;
+    for (const TTSTraceEvent &event : snapshot) {
+        char args[96];
+        if (event.chunk_index >= 0) {
+            snprintf(args, sizeof(args), "{\"request_id\":%" PRIu64 ",\"chunk\":%d}", event.request_id, event.chunk_index);
+        } else {
+            snprintf(args, sizeof(args), "{\"request_id\":%" PRIu64 "}", event.request_id);
+        }
+
+        int64_t ts = event.start_usec - origin;
+        if (event.is_wait) {
+            // Async begin/end pair; the id only has to be unique per pair
+            wait_id++;
+            snprintf(line, sizeof(line),
+                    "%s{\"name\":\"%s\",\"cat\":\"tts\",\"ph\":\"b\",\"id\":%" PRIu64 ",\"ts\":%" PRId64 ",\"pid\":1,\"tid\":%d,\"args\":%s},\n"
+                    "{\"name\":\"%s\",\"cat\":\"tts\",\"ph\":\"e\",\"id\":%" PRIu64 ",\"ts\":%" PRId64 ",\"pid\":1,\"tid\":%d}",
+                    first ? "" : ",\n", event.name, wait_id, ts, event.thread_id, args,
+                    event.name, wait_id, ts + event.duration_usec, event.thread_id);
+        } else {
+            snprintf(line, sizeof(line),
+                    "%s{\"name\":\"%s\",\"cat\":\"tts\",\"ph\":\"X\",\"ts\":%" PRId64 ",\"dur\":%" PRId64 ",\"pid\":1,\"tid\":%d,\"args\":%s}",
+                    first ? "" : ",\n", event.name, ts, event.duration_usec, event.thread_id, args);
+        }
+        json += line;
+        first = false;
+    }
+    json += "\n]}\n";
+
+    Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+    if (file.is_null()) {
+        return false;
+    }
+
+    PackedByteArray bytes;
+    bytes.resize(static_cast<int64_t>(json.size()));
+    memcpy(bytes.ptrw(), json.data(), json.size());
+    file->store_buffer(bytes);
+    return file->get_error() == OK;
+}
+
+TTSTraceScope::TTSTraceScope(TTSTracer &p_tracer, const char *p_name, uint64_t p_request_id, int p_chunk_index) :
+        tracer(p_tracer),
+        name(p_name),
+        request_id(p_request_id),
+        chunk_index(p_chunk_index),
+        start_usec(p_tracer.is_enabled() ? TTSTracer::now_usec() : 0) {
+}
+
+TTSTraceScope::~TTSTraceScope() {
+    if (start_usec > 0) {
+        tracer.add_span(name, start_usec, TTSTracer::now_usec(), request_id, chunk_index);
+    }
+}
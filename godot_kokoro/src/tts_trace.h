@@ -0,0 +1,81 @@
+#ifndef TTS_TRACE_H
+#define TTS_TRACE_H
+
+#include <godot_cpp/variant/string.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace godot {
+
+// One recorded span. Work on the recording thread becomes a Chrome trace
+// "complete" event; waits (queue, delivery) become async spans on their own
+// track, since they overlap whatever that thread does meanwhile.
+struct TTSTraceEvent {
+    const char *name;       // Must be a string literal
+    int64_t start_usec;
+    int64_t duration_usec;
+    int thread_id;
+    uint64_t request_id;    // 0 = not tied to a request
+    int chunk_index;        // -1 = not a chunk
+    bool is_wait;
+};
+
+// Fixed-size ring buffer of pipeline spans, exported as Chrome trace JSON for
+// chrome://tracing or ui.perfetto.dev. Disabled, each trace point costs one
+// relaxed atomic load; enabled, a clock read and a short lock. The oldest
+// events are overwritten once the buffer is full.
+class TTSTracer {
+private:
+    std::atomic<bool> enabled{false};
+    mutable std::mutex mutex;
+    std::vector<TTSTraceEvent> events;  // Allocated on first enable
+    size_t next_event = 0;
+    bool wrapped = false;
+    std::map<int, String> thread_names;
+
+    void add_event(const char *name, int64_t start_usec, int64_t end_usec, uint64_t request_id, int chunk_index, bool is_wait);
+
+public:
+    static const size_t CAPACITY = 65536;
+
+    static int64_t now_usec();
+    static int current_thread_id();
+
+    void set_enabled(bool p_enabled);
+    bool is_enabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Start time for a span or wait, 0 (ignored when recorded) while disabled
+    int64_t timestamp() const { return is_enabled() ? now_usec() : 0; }
+    void clear();
+
+    // Label the calling thread in exported traces
+    void name_current_thread(const String &name);
+
+    void add_span(const char *name, int64_t start_usec, int64_t end_usec, uint64_t request_id = 0, int chunk_index = -1);
+    void add_wait(const char *name, int64_t start_usec, int64_t end_usec, uint64_t request_id, int chunk_index = -1);
+
+    // Write everything recorded so far; returns false if the file could not be written
+    bool export_json(const String &path) const;
+};
+
+// Records a span covering its own lifetime, if tracing was on when it began
+class TTSTraceScope {
+private:
+    TTSTracer &tracer;
+    const char *name;
+    uint64_t request_id;
+    int chunk_index;
+    int64_t start_usec;
+
+public:
+    TTSTraceScope(TTSTracer &p_tracer, const char *p_name, uint64_t p_request_id = 0, int p_chunk_index = -1);
+    ~TTSTraceScope();
+};
+
+} // namespace godot
+
+#endif // TTS_TRACE_H
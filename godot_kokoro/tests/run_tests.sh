@@ -0,0 +1,42 @@
+#!/bin/sh
+# Builds and runs the model-free tests against the stub godot-cpp headers.
+#
+#   ./run_tests.sh              # plain build
+#   ./run_tests.sh thread       # ThreadSanitizer
+#   ./run_tests.sh address      # AddressSanitizer + UBSan
+#
+# CXX overrides the compiler (default c++). Output goes to tests/build/.
+set -e
+
+cd "$(dirname "$0")"
+SANITIZE="${1:-}"
+CXX="${CXX:-c++}"
+FLAGS="-std=c++17 -g -O1 -pthread -Wall -Wextra -Istubs -I../src"
+
+case "$SANITIZE" in
+    "")
+        NAME=test_text_to_speech
+        ;;
+    thread)
+        NAME=test_text_to_speech_tsan
+        FLAGS="$FLAGS -fsanitize=thread"
+        export TSAN_OPTIONS="${TSAN_OPTIONS:-halt_on_error=1}"
+        ;;
+    address)
+        NAME=test_text_to_speech_asan
+        FLAGS="$FLAGS -fsanitize=address,undefined -fno-omit-frame-pointer -fno-sanitize-recover=undefined"
+        ;;
+    *)
+        echo "usage: $0 [thread|address]" >&2
+        exit 2
+        ;;
+esac
+
+mkdir -p build
+$CXX $FLAGS -o "build/$NAME" \
+    test_text_to_speech.cpp \
+    sherpa_backend_stub.cpp \
+    ../src/text_to_speech.cpp \
+    ../src/mock_backend.cpp \
+    ../src/tts_trace.cpp
+"./build/$NAME" build
@@ -0,0 +1,22 @@
+#include "sherpa_backend.h"
+
+using namespace godot;
+
+// The tests only run the mock backend; this keeps sherpa-onnx out of the link
+SherpaBackend::~SherpaBackend() {}
+
+bool SherpaBackend::create(const TTSBackendConfig &) {
+    return false;
+}
+
+bool SherpaBackend::generate(const String &, int, float, const TTSAudioSink &) {
+    return false;
+}
+
+int SherpaBackend::get_sample_rate() const {
+    return 0;
+}
+
+int SherpaBackend::get_speaker_count() const {
+    return 0;
+}
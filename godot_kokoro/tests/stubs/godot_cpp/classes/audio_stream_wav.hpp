@@ -0,0 +1,28 @@
+#ifndef STUB_CLASSES_AUDIO_STREAM_WAV_HPP
+#define STUB_CLASSES_AUDIO_STREAM_WAV_HPP
+
+#include "godot_stub.hpp"
+
+namespace godot {
+
+class AudioStreamWAV : public RefCounted {
+    PackedByteArray data;
+    int mix_rate = 44100;
+
+public:
+    enum Format {
+        FORMAT_8_BITS,
+        FORMAT_16_BITS,
+    };
+
+    void set_format(Format) {}
+    void set_stereo(bool) {}
+    void set_mix_rate(int rate) { mix_rate = rate; }
+    int get_mix_rate() const { return mix_rate; }
+    void set_data(const PackedByteArray &p_data) { data = p_data; }
+    PackedByteArray get_data() const { return data; }
+};
+
+} // namespace godot
+
+#endif // STUB_CLASSES_AUDIO_STREAM_WAV_HPP
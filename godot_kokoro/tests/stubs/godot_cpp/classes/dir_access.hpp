@@ -0,0 +1,35 @@
+#ifndef STUB_CLASSES_DIR_ACCESS_HPP
+#define STUB_CLASSES_DIR_ACCESS_HPP
+
+#include "godot_stub.hpp"
+
+#include <cstdio>
+#include <filesystem>
+
+namespace godot {
+
+class DirAccess : public RefCounted {
+public:
+    static Error remove_absolute(const String &path) {
+        return ::remove(path.utf8().get_data()) == 0 ? OK : FAILED;
+    }
+
+    static PackedStringArray get_files_at(const String &path) { return list(path, false); }
+    static PackedStringArray get_directories_at(const String &path) { return list(path, true); }
+
+private:
+    static PackedStringArray list(const String &path, bool directories) {
+        PackedStringArray names;
+        std::error_code error;
+        for (const auto &entry : std::filesystem::directory_iterator(path.utf8().get_data(), error)) {
+            if (entry.is_directory() == directories) {
+                names.push_back(String(entry.path().filename().string().c_str()));
+            }
+        }
+        return names;
+    }
+};
+
+} // namespace godot
+
+#endif // STUB_CLASSES_DIR_ACCESS_HPP
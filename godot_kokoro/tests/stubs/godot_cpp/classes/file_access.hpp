@@ -0,0 +1,59 @@
+#ifndef STUB_CLASSES_FILE_ACCESS_HPP
+#define STUB_CLASSES_FILE_ACCESS_HPP
+
+#include "godot_stub.hpp"
+
+#include <cstdio>
+
+namespace godot {
+
+// Backed by stdio so rendered files and traces can be inspected by the test
+class FileAccess : public RefCounted {
+    FILE *file = nullptr;
+
+public:
+    enum ModeFlags {
+        READ = 1,
+        WRITE = 2,
+    };
+
+    static Ref<FileAccess> open(const String &path, ModeFlags mode) {
+        Ref<FileAccess> ref;
+        FILE *file = fopen(path.utf8().get_data(), mode == READ ? "rb" : "wb");
+        if (file) {
+            ref.instantiate();
+            ref->file = file;
+        }
+        return ref;
+    }
+
+    ~FileAccess() { close(); }
+
+    void store_buffer(const PackedByteArray &buffer) { fwrite(buffer.ptr(), 1, buffer.size(), file); }
+    void store_32(uint32_t value) { fwrite(&value, 4, 1, file); }
+    void store_16(uint16_t value) { fwrite(&value, 2, 1, file); }
+    void store_string(const String &text) {
+        CharString utf8 = text.utf8();
+        fwrite(utf8.get_data(), 1, utf8.length(), file);
+    }
+    void seek(uint64_t position) { fseek(file, static_cast<long>(position), SEEK_SET); }
+    uint64_t get_length() const {
+        long position = ftell(file);
+        fseek(file, 0, SEEK_END);
+        long length = ftell(file);
+        fseek(file, position, SEEK_SET);
+        return static_cast<uint64_t>(length);
+    }
+    Error get_error() const { return file && ferror(file) ? FAILED : OK; }
+
+    void close() {
+        if (file) {
+            fclose(file);
+            file = nullptr;
+        }
+    }
+};
+
+} // namespace godot
+
+#endif // STUB_CLASSES_FILE_ACCESS_HPP
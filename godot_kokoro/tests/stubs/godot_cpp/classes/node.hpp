@@ -0,0 +1,6 @@
+#ifndef STUB_CLASSES_NODE_HPP
+#define STUB_CLASSES_NODE_HPP
+
+#include "godot_stub.hpp"
+
+#endif // STUB_CLASSES_NODE_HPP
@@ -0,0 +1,25 @@
+#ifndef STUB_CLASSES_OS_HPP
+#define STUB_CLASSES_OS_HPP
+
+#include "godot_stub.hpp"
+
+#include <thread>
+
+namespace godot {
+
+class OS : public Object {
+public:
+    static OS *get_singleton() {
+        static OS singleton;
+        return &singleton;
+    }
+
+    int get_processor_count() const {
+        unsigned int count = std::thread::hardware_concurrency();
+        return count > 0 ? static_cast<int>(count) : 1;
+    }
+};
+
+} // namespace godot
+
+#endif // STUB_CLASSES_OS_HPP
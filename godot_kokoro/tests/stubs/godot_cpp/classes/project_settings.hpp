@@ -0,0 +1,22 @@
+#ifndef STUB_CLASSES_PROJECT_SETTINGS_HPP
+#define STUB_CLASSES_PROJECT_SETTINGS_HPP
+
+#include "godot_stub.hpp"
+
+namespace godot {
+
+// Paths are used as given and every setting has its default value
+class ProjectSettings : public Object {
+public:
+    static ProjectSettings *get_singleton() {
+        static ProjectSettings singleton;
+        return &singleton;
+    }
+
+    String globalize_path(const String &path) const { return path; }
+    Variant get_setting(const String &, const Variant &default_value = Variant()) const { return default_value; }
+};
+
+} // namespace godot
+
+#endif // STUB_CLASSES_PROJECT_SETTINGS_HPP
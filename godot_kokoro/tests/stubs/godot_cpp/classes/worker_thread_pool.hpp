@@ -0,0 +1,62 @@
+#ifndef STUB_CLASSES_WORKER_THREAD_POOL_HPP
+#define STUB_CLASSES_WORKER_THREAD_POOL_HPP
+
+#include "godot_stub.hpp"
+#include "godot_cpp/variant/callable_method_pointer.hpp"
+
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace godot {
+
+// Runs every task on its own thread, which is enough to exercise the pool
+// mode's slot claiming and task accounting
+class WorkerThreadPool : public Object {
+    std::mutex mutex;
+    std::map<int64_t, std::thread> threads;
+    std::map<int64_t, bool> completed;
+    int64_t next_task_id = 1;
+
+public:
+    static WorkerThreadPool *get_singleton() {
+        static WorkerThreadPool singleton;
+        return &singleton;
+    }
+
+    int64_t add_task(const Callable &action, bool = false, const String & = String()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        int64_t task_id = next_task_id++;
+        completed[task_id] = false;
+        threads[task_id] = std::thread([this, action, task_id] {
+            action.call();
+            std::lock_guard<std::mutex> lock(mutex);
+            completed[task_id] = true;
+        });
+        return task_id;
+    }
+
+    bool is_task_completed(int64_t task_id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return completed[task_id];
+    }
+
+    Error wait_for_task_completion(int64_t task_id) {
+        std::thread thread;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            thread = std::move(threads[task_id]);
+            threads.erase(task_id);
+        }
+        if (thread.joinable()) {
+            thread.join();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        completed.erase(task_id);
+        return OK;
+    }
+};
+
+} // namespace godot
+
+#endif // STUB_CLASSES_WORKER_THREAD_POOL_HPP
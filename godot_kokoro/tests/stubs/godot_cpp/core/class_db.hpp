@@ -0,0 +1,6 @@
+#ifndef STUB_CORE_CLASS_DB_HPP
+#define STUB_CORE_CLASS_DB_HPP
+
+#include "godot_stub.hpp"
+
+#endif // STUB_CORE_CLASS_DB_HPP
@@ -0,0 +1,29 @@
+#ifndef STUB_VARIANT_CALLABLE_METHOD_POINTER_HPP
+#define STUB_VARIANT_CALLABLE_METHOD_POINTER_HPP
+
+#include "godot_stub.hpp"
+
+#include <functional>
+
+namespace godot {
+
+struct Callable {
+    std::function<void()> function;
+
+    void call() const {
+        if (function) {
+            function();
+        }
+    }
+};
+
+template <class T>
+Callable callable_mp(T *instance, void (T::*method)()) {
+    Callable callable;
+    callable.function = [instance, method] { (instance->*method)(); };
+    return callable;
+}
+
+} // namespace godot
+
+#endif // STUB_VARIANT_CALLABLE_METHOD_POINTER_HPP
@@ -0,0 +1,6 @@
+#ifndef STUB_VARIANT_DICTIONARY_HPP
+#define STUB_VARIANT_DICTIONARY_HPP
+
+#include "godot_stub.hpp"
+
+#endif // STUB_VARIANT_DICTIONARY_HPP
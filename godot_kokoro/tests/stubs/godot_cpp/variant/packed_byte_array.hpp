@@ -0,0 +1,6 @@
+#ifndef STUB_VARIANT_PACKED_BYTE_ARRAY_HPP
+#define STUB_VARIANT_PACKED_BYTE_ARRAY_HPP
+
+#include "godot_stub.hpp"
+
+#endif // STUB_VARIANT_PACKED_BYTE_ARRAY_HPP
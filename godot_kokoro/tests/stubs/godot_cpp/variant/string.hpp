@@ -0,0 +1,6 @@
+#ifndef STUB_VARIANT_STRING_HPP
+#define STUB_VARIANT_STRING_HPP
+
+#include "godot_stub.hpp"
+
+#endif // STUB_VARIANT_STRING_HPP
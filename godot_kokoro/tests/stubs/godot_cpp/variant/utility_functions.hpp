@@ -0,0 +1,6 @@
+#ifndef STUB_VARIANT_UTILITY_FUNCTIONS_HPP
+#define STUB_VARIANT_UTILITY_FUNCTIONS_HPP
+
+#include "godot_stub.hpp"
+
+#endif // STUB_VARIANT_UTILITY_FUNCTIONS_HPP
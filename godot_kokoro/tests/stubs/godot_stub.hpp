@@ -0,0 +1,269 @@
+#ifndef GODOT_STUB_HPP
+#define GODOT_STUB_HPP
+
+// Minimal stand-ins for the parts of godot-cpp that TextToSpeech uses, so the
+// scheduling and threading code can be built and run as a plain executable
+// (and under sanitizers) without an engine. Signals emitted or deferred by an
+// Object are handed to stub_record_signal(), which the test defines.
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace godot {
+
+struct CharString {
+    std::string data;
+
+    const char *get_data() const { return data.c_str(); }
+    int length() const { return static_cast<int>(data.size()); }
+};
+
+struct String {
+    std::u32string data;
+
+    String() {}
+    String(const char *text) {
+        while (*text) {
+            data.push_back(static_cast<unsigned char>(*text++));
+        }
+    }
+
+    static String num_int64(int64_t number) { return String(std::to_string(number).c_str()); }
+    static String chr(char32_t c) {
+        String s;
+        s.data.push_back(c);
+        return s;
+    }
+
+    bool is_empty() const { return data.empty(); }
+    int64_t length() const { return static_cast<int64_t>(data.size()); }
+    char32_t operator[](int64_t i) const { return data[i]; }
+
+    String operator+(const String &other) const {
+        String s = *this;
+        s.data += other.data;
+        return s;
+    }
+    String operator+(const char *other) const { return *this + String(other); }
+    String &operator+=(const String &other) {
+        data += other.data;
+        return *this;
+    }
+    bool operator==(const String &other) const { return data == other.data; }
+    bool operator!=(const String &other) const { return data != other.data; }
+    bool operator<(const String &other) const { return data < other.data; }
+
+    String substr(int64_t from, int64_t count = -1) const {
+        String s;
+        if (from < length()) {
+            s.data = data.substr(from, count < 0 ? std::u32string::npos : static_cast<size_t>(count));
+        }
+        return s;
+    }
+    String strip_edges(bool = true, bool = true) const {
+        size_t begin = 0;
+        size_t end = data.size();
+        while (begin < end && data[begin] <= 32) begin++;
+        while (end > begin && data[end - 1] <= 32) end--;
+        return substr(begin, end - begin);
+    }
+    String to_lower() const {
+        String s = *this;
+        for (char32_t &c : s.data) {
+            if (c >= 'A' && c <= 'Z') c += 32;
+        }
+        return s;
+    }
+    String path_join(const String &file) const { return *this + "/" + file; }
+    // Only used to pick the render format, and tests pass bare extensions
+    String get_extension() const { return *this; }
+
+    // Code points are truncated to bytes; tests only use ASCII
+    CharString utf8() const {
+        CharString c;
+        for (char32_t ch : data) {
+            c.data.push_back(static_cast<char>(ch));
+        }
+        return c;
+    }
+};
+
+inline String operator+(const char *a, const String &b) { return String(a) + b; }
+
+struct StringName {
+    std::string name;
+
+    StringName() {}
+    StringName(const char *p_name) : name(p_name) {}
+};
+
+// Only integers survive the round trip; everything else becomes 0
+struct Variant {
+    int64_t value = 0;
+
+    Variant() {}
+    template <class T>
+    Variant(const T &v) {
+        if constexpr (std::is_arithmetic_v<T>) {
+            value = static_cast<int64_t>(v);
+        }
+    }
+    operator int64_t() const { return value; }
+};
+
+struct PackedByteArray {
+    std::vector<uint8_t> data;
+
+    int64_t size() const { return static_cast<int64_t>(data.size()); }
+    bool is_empty() const { return data.empty(); }
+    void resize(int64_t n) { data.resize(n); }
+    void clear() { data.clear(); }
+    uint8_t *ptrw() { return data.data(); }
+    const uint8_t *ptr() const { return data.data(); }
+    PackedByteArray slice(int64_t begin, int64_t end) const {
+        PackedByteArray s;
+        s.data.assign(data.begin() + begin, data.begin() + end);
+        return s;
+    }
+};
+
+struct PackedStringArray {
+    std::vector<String> data;
+
+    int64_t size() const { return static_cast<int64_t>(data.size()); }
+    bool is_empty() const { return data.empty(); }
+    void push_back(const String &s) { data.push_back(s); }
+    const String &operator[](int64_t i) const { return data[i]; }
+};
+
+struct Dictionary {
+    std::map<String, Variant> values;
+
+    Variant &operator[](const String &key) { return values[key]; }
+    bool has(const String &key) const { return values.count(key) != 0; }
+};
+
+enum Error {
+    OK = 0,
+    FAILED = 1,
+};
+
+template <class T>
+struct Ref;
+
+struct SignalRecord {
+    std::string name;
+    std::vector<int64_t> args;
+    std::vector<std::shared_ptr<void>> objects;  // Keeps recorded objects alive so identities stay unique
+};
+
+void stub_record_signal(const SignalRecord &record);
+
+template <class T>
+void stub_add_arg(SignalRecord &record, const T &arg) {
+    if constexpr (std::is_integral_v<T>) {
+        record.args.push_back(static_cast<int64_t>(arg));
+    } else {
+        record.args.push_back(-1);
+    }
+}
+
+// Objects are recorded by identity, so tests can tell shared results apart
+template <class T>
+void stub_add_arg(SignalRecord &record, const Ref<T> &arg) {
+    record.args.push_back(static_cast<int64_t>(reinterpret_cast<intptr_t>(arg.ptr())));
+    record.objects.push_back(arg.reference);
+}
+
+class Object {
+public:
+    virtual ~Object() {}
+
+    template <class... Args>
+    void emit_signal(const StringName &signal, Args... args) {
+        SignalRecord record;
+        record.name = signal.name;
+        (stub_add_arg(record, args), ...);
+        stub_record_signal(record);
+    }
+
+    // Only ever used as call_deferred("emit_signal", ...), recorded immediately
+    template <class... Args>
+    void call_deferred(const StringName &, const char *signal, Args... args) {
+        emit_signal(signal, args...);
+    }
+};
+
+class RefCounted : public Object {};
+
+template <class T>
+struct Ref {
+    std::shared_ptr<T> reference;
+
+    void instantiate() { reference = std::make_shared<T>(); }
+    bool is_valid() const { return reference != nullptr; }
+    bool is_null() const { return reference == nullptr; }
+    void unref() { reference.reset(); }
+    T *operator->() const { return reference.get(); }
+    T *ptr() const { return reference.get(); }
+};
+
+class Node : public Object {};
+
+struct PropertyInfo {
+    template <class... Args>
+    PropertyInfo(Args...) {}
+};
+
+struct MethodInfo {
+    template <class... Args>
+    MethodInfo(Args...) {}
+};
+
+enum PropertyHint {
+    PROPERTY_HINT_NONE,
+    PROPERTY_HINT_RANGE,
+    PROPERTY_HINT_ENUM,
+    PROPERTY_HINT_FILE,
+    PROPERTY_HINT_GLOBAL_FILE,
+};
+
+struct MethodDefinition {};
+
+template <class... Args>
+MethodDefinition D_METHOD(Args...) { return MethodDefinition(); }
+
+template <class T>
+Variant DEFVAL(const T &value) { return Variant(value); }
+
+struct ClassDB {
+    template <class... Args>
+    static void bind_method(Args...) {}
+    template <class... Args>
+    static void bind_static_method(Args...) {}
+    template <class... Args>
+    static void bind_integer_constant(Args...) {}
+};
+
+struct UtilityFunctions {
+    template <class... Args>
+    static void print(Args...) {}
+    template <class... Args>
+    static void printerr(Args...) {}
+};
+
+} // namespace godot
+
+#define GDCLASS(m_class, m_inherits)
+#define ADD_PROPERTY(...)
+#define ADD_SIGNAL(...)
+#define ADD_GROUP(...)
+#define BIND_ENUM_CONSTANT(m_constant)
+#define VARIANT_ENUM_CAST(m_enum)
+
+#endif // GODOT_STUB_HPP
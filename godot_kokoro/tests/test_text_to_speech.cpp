@@ -0,0 +1,733 @@
+// Model-free tests for TextToSpeech's scheduling, streaming and rendering,
+// built against the stub godot-cpp headers in stubs/ and the mock backend.
+// Every test runs twice: once on the dedicated worker threads and once on
+// the WorkerThreadPool. See run_tests.sh for the normal and sanitizer builds.
+
+#include "text_to_speech.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace godot;
+
+static std::mutex signal_mutex;
+static std::vector<SignalRecord> signals;
+
+void godot::stub_record_signal(const SignalRecord &record) {
+    std::lock_guard<std::mutex> lock(signal_mutex);
+    signals.push_back(record);
+}
+
+// Signals recorded since the last call
+static std::vector<SignalRecord> take_signals() {
+    std::lock_guard<std::mutex> lock(signal_mutex);
+    std::vector<SignalRecord> taken;
+    taken.swap(signals);
+    return taken;
+}
+
+static int failures = 0;
+static bool use_pool = false;
+static std::string output_dir = ".";
+
+#define CHECK(m_cond)                                                          \
+    do {                                                                       \
+        if (!(m_cond)) {                                                       \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #m_cond);           \
+            failures++;                                                        \
+        }                                                                      \
+    } while (0)
+
+static String output_path(const char *name) {
+    return String((output_dir + "/" + name).c_str());
+}
+
+// Stand-in for the main loop: _process delivers results and dispatches pool tasks
+static void pump(TextToSpeech &tts, int msec) {
+    for (int elapsed = 0; elapsed < msec; elapsed += 5) {
+        tts._process(0.005);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+// Pump until every id got a signal that ends it (or the timeout passes);
+// returns the ids that are still unfinished
+static std::set<int64_t> wait_for_terminal(TextToSpeech &tts, std::set<int64_t> ids, int timeout_msec) {
+    for (int elapsed = 0; elapsed < timeout_msec && !ids.empty(); elapsed += 5) {
+        tts._process(0.005);
+        for (const SignalRecord &s : take_signals()) {
+            if (s.name == "generation_completed" || s.name == "generation_failed" ||
+                    s.name == "stream_completed" || s.name == "render_completed") {
+                ids.erase(s.args[0]);
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return ids;
+}
+
+// Pump until stream_completed for `id` (or the timeout passes); returns the
+// signals seen meanwhile, so the result does not depend on machine speed
+static std::vector<SignalRecord> pump_stream(TextToSpeech &tts, uint64_t id, int timeout_msec) {
+    std::vector<SignalRecord> seen;
+    for (int elapsed = 0; elapsed < timeout_msec; elapsed += 5) {
+        tts._process(0.005);
+        bool completed = false;
+        for (const SignalRecord &s : take_signals()) {
+            completed = completed || (s.name == "stream_completed" && static_cast<uint64_t>(s.args[0]) == id);
+            seen.push_back(s);
+        }
+        if (completed) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return seen;
+}
+
+// Mock parameters are applied by load_model(), so callers set them first
+static void load_mock(TextToSpeech &tts, float latency = 0.0f, float real_time_factor = 0.0f) {
+    tts.set_backend(TextToSpeech::BACKEND_MOCK);
+    tts.set_use_worker_thread_pool(use_pool);
+    tts.set_mock_latency(latency);
+    tts.set_mock_real_time_factor(real_time_factor);
+    tts.load_model("", "", "");
+    CHECK(tts.is_model_loaded());
+    take_signals();
+}
+
+static void test_parallel_stream_order() {
+    TextToSpeech tts;
+    tts.set_parallel_workers(4);
+    tts.set_stream_lookahead(0);
+    load_mock(tts, 0.01f, 0.05f);
+
+    uint64_t id = tts.speak_streaming("One. Two two two two two two. Three. Four four four four. Five. Six.");
+
+    int next_index = 0;
+    bool completed = false;
+    for (const SignalRecord &s : pump_stream(tts, id, 10000)) {
+        if (s.name == "chunk_ready" && static_cast<uint64_t>(s.args[0]) == id) {
+            CHECK(s.args[1] == next_index);
+            next_index++;
+        } else if (s.name == "stream_completed") {
+            CHECK(next_index == 6);
+            completed = true;
+        }
+    }
+    CHECK(next_index == 6);
+    CHECK(completed);
+}
+
+static void test_coalescing() {
+    TextToSpeech tts;
+    load_mock(tts, 0.05f);
+
+    uint64_t a = tts.speak_async("Hello there.");
+    uint64_t b = tts.speak_async("Hello there.");
+    uint64_t c = tts.speak_async("Other.");
+    uint64_t d = tts.speak_async("Hello there.");
+    pump(tts, 500);
+
+    // Identical requests share a generation, so they receive the same audio
+    // object, but each still gets its own completion
+    std::map<int64_t, int> completions;
+    std::map<int64_t, int64_t> audio;
+    for (const SignalRecord &s : take_signals()) {
+        if (s.name == "generation_completed") {
+            completions[s.args[0]]++;
+            audio[s.args[0]] = s.args[1];
+        }
+    }
+    CHECK(completions[a] == 1);
+    CHECK(completions[b] == 1);
+    CHECK(completions[c] == 1);
+    CHECK(completions[d] == 1);
+    CHECK(audio[a] != 0);
+    CHECK(audio[b] == audio[a]);
+    CHECK(audio[d] == audio[a]);
+    CHECK(audio[c] != audio[a]);
+}
+
+static void test_coalescing_disabled() {
+    TextToSpeech tts;
+    tts.set_coalesce_requests(false);
+    load_mock(tts, 0.05f);
+
+    uint64_t a = tts.speak_async("Hello there.");
+    uint64_t b = tts.speak_async("Hello there.");
+    pump(tts, 300);
+
+    std::map<int64_t, int64_t> audio;
+    for (const SignalRecord &s : take_signals()) {
+        if (s.name == "generation_completed") {
+            audio[s.args[0]] = s.args[1];
+        }
+    }
+    CHECK(audio[a] != 0);
+    CHECK(audio[b] != 0);
+    CHECK(audio[a] != audio[b]);
+}
+
+static void test_fed_stream() {
+    TextToSpeech tts;
+    tts.set_parallel_workers(2);
+    load_mock(tts);
+
+    uint64_t id = tts.begin_stream();
+    const char *tokens[] = { "Hel", "lo. ", "How are", " you? I am", " fine", "." };
+    for (const char *token : tokens) {
+        CHECK(tts.feed_text(id, token));
+        pump(tts, 20);
+    }
+    std::vector<SignalRecord> before_end = take_signals();
+    for (const SignalRecord &s : before_end) {
+        CHECK(s.name != "stream_completed");
+    }
+
+    CHECK(tts.end_stream(id));
+    pump(tts, 300);
+    std::vector<SignalRecord> after_end = take_signals();
+
+    int next_index = 0;
+    bool completed = false;
+    for (const std::vector<SignalRecord> *batch : { &before_end, &after_end }) {
+        for (const SignalRecord &s : *batch) {
+            if (s.name == "chunk_ready") {
+                CHECK(s.args[1] == next_index);
+                next_index++;
+            } else if (s.name == "stream_completed") {
+                completed = true;
+            }
+        }
+    }
+    CHECK(next_index == 3);
+    CHECK(completed);
+    CHECK(!tts.feed_text(id, "Too late."));
+
+    // Chunks delivered after end_stream() report the now known count
+    uint64_t closed = tts.begin_stream();
+    CHECK(tts.feed_text(closed, "One. Two. Three"));
+    CHECK(tts.end_stream(closed));
+    int delivered = 0;
+    for (const SignalRecord &s : pump_stream(tts, closed, 5000)) {
+        if (s.name == "chunk_ready" && static_cast<uint64_t>(s.args[0]) == closed) {
+            CHECK(s.args[2] == 3);
+            delivered++;
+        }
+    }
+    CHECK(delivered == 3);
+}
+
+// A stream whose last chunk fails reports generation_failed and never
+// completes, whether it came from speak_streaming() or begin_stream()
+static void test_failed_last_chunk() {
+    TextToSpeech tts;
+    load_mock(tts);
+    tts.set_speed(0.0f);  // The mock rejects every chunk
+
+    uint64_t streamed = tts.speak_streaming("One. Two.");
+    uint64_t fed_late = tts.begin_stream();
+    tts.feed_text(fed_late, "One. Two.");
+    tts.end_stream(fed_late);
+    uint64_t fed_early = tts.begin_stream();
+    tts.feed_text(fed_early, "One. Two. ");
+    pump(tts, 200);
+    tts.end_stream(fed_early);  // Both chunks already delivered
+    pump(tts, 100);
+
+    std::map<int64_t, int> failed;
+    for (const SignalRecord &s : take_signals()) {
+        CHECK(s.name != "stream_completed");
+        CHECK(s.name != "chunk_ready");
+        if (s.name == "generation_failed") {
+            failed[s.args[0]]++;
+        }
+    }
+    CHECK(failed[streamed] == 2);
+    CHECK(failed[fed_late] == 2);
+    CHECK(failed[fed_early] == 2);
+    CHECK(!tts.feed_text(fed_early, "Closed."));
+}
+
+// Work queued before a model load that fails still gets a terminal signal
+static void test_failed_reload() {
+    TextToSpeech tts;
+    load_mock(tts, 0.05f);
+
+    std::set<int64_t> ids;
+    for (int i = 0; i < 3; i++) {
+        ids.insert(tts.speak_async(String("Queued line ") + String::num_int64(i) + "."));
+    }
+    ids.insert(tts.speak_streaming("One. Two. Three."));
+    ids.insert(tts.render_to_file("One. Two.", output_path("failed_reload.wav")));
+
+    tts.set_backend(TextToSpeech::BACKEND_SHERPA);  // The stub never loads
+    tts.load_model("", "", "");
+    CHECK(!tts.is_model_loaded());
+
+    CHECK(wait_for_terminal(tts, ids, 2000).empty());
+    CHECK(!tts.is_generating());
+}
+
+static void write_file(const std::filesystem::path &path, size_t bytes) {
+    std::filesystem::create_directories(path.parent_path());
+    FILE *file = fopen(path.string().c_str(), "wb");
+    CHECK(file != nullptr);
+    if (file) {
+        std::string data(bytes, 'x');
+        fwrite(data.data(), 1, data.size(), file);
+        fclose(file);
+    }
+}
+
+// The model estimate includes data_dir and dict_dir, recursively
+static void test_memory_usage() {
+    std::filesystem::path root = std::filesystem::path(output_dir) / "model_dirs";
+    std::filesystem::remove_all(root);
+    write_file(root / "espeak-ng-data" / "phontab", 100);
+    write_file(root / "espeak-ng-data" / "voices" / "en", 250);
+    write_file(root / "dict" / "jieba.dict", 50);
+
+    TextToSpeech tts;
+    tts.set_backend(TextToSpeech::BACKEND_MOCK);
+    tts.set_use_worker_thread_pool(use_pool);
+    tts.load_model("", "", "", String((root / "espeak-ng-data").string().c_str()), "",
+            String((root / "dict").string().c_str()));
+    CHECK(tts.is_model_loaded());
+    take_signals();
+
+    Dictionary usage = tts.get_memory_usage();
+    CHECK(static_cast<int64_t>(usage["model"]) == 400);
+    CHECK(static_cast<int64_t>(usage["total"]) >= 400);
+}
+
+// Several threads call every public entry point at once while another keeps
+// reloading the model. The first phase includes cancellation and is mostly
+// here for TSAN and ASAN; the second leaves it out, so every id handed out
+// must then reach a terminal signal, including across failed reloads.
+static void test_stress() {
+    TextToSpeech tts;
+    tts.set_parallel_workers(3);
+    tts.set_idle_unload_timeout(0.05f);
+    load_mock(tts, 0.01f);  // Slow enough for a backlog to build up
+
+    std::mutex ids_mutex;
+    std::set<int64_t> ids;
+    auto track = [&](uint64_t id) {
+        if (id != 0) {
+            std::lock_guard<std::mutex> lock(ids_mutex);
+            ids.insert(static_cast<int64_t>(id));
+        }
+    };
+
+    for (bool cancelling : { true, false }) {
+        std::atomic<bool> stop{false};
+        std::vector<std::thread> callers;
+        for (int k = 0; k < 4; k++) {
+            callers.emplace_back([&, k] {
+                String render_path = output_path("stress_") + String::chr(U'0' + k) + ".wav";
+                for (int i = 0; !stop; i++) {
+                    switch ((i + k) % 6) {
+                        case 0:
+                            track(tts.speak_async("Repeat line."));
+                            break;
+                        case 1:
+                            track(tts.speak_streaming("A. B. C."));
+                            break;
+                        case 2:
+                            tts.speak("Sync.");
+                            break;
+                        case 3:
+                            if (cancelling) {
+                                tts.cancel_generation();
+                            }
+                            break;
+                        case 4: {
+                            uint64_t stream = tts.begin_stream();
+                            tts.feed_text(stream, "x. y");
+                            tts.end_stream(stream);
+                            track(stream);
+                        } break;
+                        case 5:
+                            tts.is_generating();
+                            tts.get_memory_usage();
+                            if (i % 12 == 5) {
+                                uint64_t render = tts.render_to_file("One. Two. Three.", render_path);
+                                track(render);
+                                if (cancelling && i % 24 == 5) {
+                                    tts.cancel_render(render);
+                                }
+                            }
+                            if (i % 18 == 5) {
+                                tts.set_trace_enabled(i % 36 == 5);
+                            }
+                            if (i % 30 == 5) {
+                                tts.export_trace(output_path("stress_trace.json"));
+                            }
+                            break;
+                    }
+                }
+            });
+        }
+        // The uncancelled phase also fails every other reload, ending on a
+        // failure so nothing queued afterwards restarts the workers for it
+        std::thread loader([&] {
+            for (int i = 0; i < 6; i++) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(60));
+                if (!cancelling) {
+                    tts.set_backend(i % 2 == 1 ? TextToSpeech::BACKEND_SHERPA : TextToSpeech::BACKEND_MOCK);
+                }
+                tts.load_model("", "", "");
+            }
+        });
+
+        pump(tts, 500);
+        stop = true;
+        for (std::thread &caller : callers) {
+            caller.join();
+        }
+        loader.join();
+
+        if (cancelling) {
+            // cancel_generation() drops queued work without a signal
+            pump(tts, 200);
+            take_signals();
+            ids.clear();
+        } else {
+            std::set<int64_t> unfinished = wait_for_terminal(tts, ids, 10000);
+            CHECK(ids.size() > 0);
+            CHECK(unfinished.empty());
+            CHECK(!tts.is_generating());
+        }
+    }
+
+    Dictionary usage = tts.get_memory_usage();
+    CHECK(usage.has("total"));
+}
+
+static void test_lookahead() {
+    TextToSpeech tts;
+    tts.set_parallel_workers(2);
+    tts.set_stream_lookahead(1.0f);
+    load_mock(tts, 0.0f, 0.02f);
+
+    String text;
+    for (int i = 0; i < 20; i++) {
+        text += "Word word. ";
+    }
+    tts.speak_streaming(text);
+    pump(tts, 400);
+
+    // Each chunk is 0.6 s of audio, so with 1 s of lookahead only a few can
+    // be ready after 0.4 s even though generation is far faster than that
+    int chunks = 0;
+    for (const SignalRecord &s : take_signals()) {
+        if (s.name == "chunk_ready") {
+            chunks++;
+        }
+    }
+    CHECK(chunks >= 2 && chunks <= 5);
+    tts.cancel_generation();
+}
+
+static bool file_exists(const String &path) {
+    FILE *file = fopen(path.utf8().get_data(), "rb");
+    if (file) {
+        fclose(file);
+    }
+    return file != nullptr;
+}
+
+static uint32_t read_u32(const unsigned char *bytes) {
+    uint32_t value;
+    memcpy(&value, bytes, 4);
+    return value;
+}
+
+static void test_render_to_file() {
+    TextToSpeech tts;
+    tts.set_parallel_workers(2);
+    load_mock(tts);
+
+    String text;
+    for (int i = 0; i < 12; i++) {
+        text += "Line number. ";
+    }
+    String path = output_path("render.wav");
+    CHECK(tts.render_to_file(text, path, "ogg") == 0);
+
+    uint64_t id = tts.render_to_file(text, path);
+    uint64_t interactive = tts.speak_async("Interactive.");
+    pump(tts, 600);
+
+    int progress = 0;
+    bool rendered = false;
+    bool interactive_done = false;
+    for (const SignalRecord &s : take_signals()) {
+        if (s.name == "render_progress" && static_cast<uint64_t>(s.args[0]) == id) {
+            progress++;
+            CHECK(s.args[1] == progress);
+        } else if (s.name == "render_completed") {
+            rendered = true;
+        } else if (s.name == "generation_completed" && static_cast<uint64_t>(s.args[0]) == interactive) {
+            interactive_done = true;
+        }
+    }
+    CHECK(progress == 12);
+    CHECK(rendered);
+    CHECK(interactive_done);
+    CHECK(!tts.is_generating());
+
+    FILE *file = fopen(path.utf8().get_data(), "rb");
+    CHECK(file != nullptr);
+    if (file) {
+        unsigned char header[44];
+        CHECK(fread(header, 1, sizeof(header), file) == sizeof(header));
+        fseek(file, 0, SEEK_END);
+        long length = ftell(file);
+        fclose(file);
+
+        uint32_t data_bytes = read_u32(header + 40);
+        CHECK(memcmp(header, "RIFF", 4) == 0);
+        CHECK(memcmp(header + 36, "data", 4) == 0);
+        CHECK(read_u32(header + 4) == data_bytes + 36);
+        CHECK(read_u32(header + 24) == 24000);
+        CHECK(static_cast<long>(data_bytes) + 44 == length);
+        CHECK(data_bytes == 12u * 2u * static_cast<uint32_t>(12 * 0.06f * 24000));
+    }
+
+    // A cancelled render fails and leaves no partial file behind
+    tts.set_mock_real_time_factor(0.05f);
+    tts.load_model("", "", "");
+    take_signals();
+    String cancel_path = output_path("render_cancelled.wav");
+    uint64_t cancelled = tts.render_to_file(text, cancel_path);
+    pump(tts, 80);
+    CHECK(tts.cancel_render(cancelled));
+    CHECK(!tts.cancel_render(cancelled));
+    pump(tts, 300);
+
+    bool failed = false;
+    for (const SignalRecord &s : take_signals()) {
+        if (s.name == "generation_failed" && static_cast<uint64_t>(s.args[0]) == cancelled) {
+            failed = true;
+        }
+    }
+    CHECK(failed);
+    CHECK(!file_exists(cancel_path));
+    CHECK(!tts.is_generating());
+}
+
+// Freeing the node mid-render removes the partial file too
+static void test_render_abandoned() {
+    String path = output_path("render_abandoned.wav");
+    {
+        TextToSpeech tts;
+        load_mock(tts, 0.0f, 0.05f);
+        String text;
+        for (int i = 0; i < 12; i++) {
+            text += "Line number. ";
+        }
+        CHECK(tts.render_to_file(text, path) != 0);
+        pump(tts, 80);
+        CHECK(file_exists(path));
+    }
+    take_signals();
+    CHECK(!file_exists(path));
+}
+
+static void test_adaptive_chunking() {
+    TextToSpeech tts;
+    tts.set_adaptive_chunking(true);
+    tts.set_stream_lookahead(0);
+    load_mock(tts, 0.0f, 0.05f);
+
+    String text = "Well then, before we set off on this long road together, listen closely. ";
+    for (int i = 0; i < 10; i++) {
+        text += "Here is another sentence of the story. ";
+    }
+    CHECK(tts.get_measured_real_time_factor() == 0.0f);
+
+    // Unmeasured: the first clause, the rest of its sentence, then one chunk per sentence
+    uint64_t first = tts.speak_streaming(text);
+    int first_total = -1;
+    for (const SignalRecord &s : pump_stream(tts, first, 10000)) {
+        if (s.name == "chunk_ready") {
+            first_total = static_cast<int>(s.args[2]);
+        }
+    }
+    CHECK(first_total == 12);
+
+    float rtf = tts.get_measured_real_time_factor();
+    CHECK(rtf > 0.03f && rtf < 0.2f);
+
+    // Measured and fast: later sentences are merged into fewer chunks
+    uint64_t second = tts.speak_streaming(text);
+    int total = -1;
+    int chunks = 0;
+    for (const SignalRecord &s : pump_stream(tts, second, 10000)) {
+        if (s.name == "chunk_ready") {
+            total = static_cast<int>(s.args[2]);
+            chunks++;
+        }
+    }
+    CHECK(total >= 3 && total < 8);
+    CHECK(chunks == total);
+}
+
+static void test_trace_export() {
+    TextToSpeech tts;
+    tts.set_parallel_workers(2);
+    load_mock(tts, 0.0f, 0.02f);
+
+    tts.speak_async("Untraced.");
+    pump(tts, 200);
+
+    tts.set_trace_enabled(true);
+    tts.speak_async("Hello there.");
+    tts.speak_streaming("One. Two. Three.");
+    tts.render_to_file("A. B.", output_path("traced.wav"));
+    tts.speak("Sync.");
+    pump(tts, 500);
+    take_signals();
+
+    String path = output_path("trace.json");
+    CHECK(tts.export_trace(path));
+    FILE *file = fopen(path.utf8().get_data(), "rb");
+    CHECK(file != nullptr);
+    if (file) {
+        std::string json;
+        char buffer[4096];
+        size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            json.append(buffer, read);
+        }
+        fclose(file);
+        CHECK(json.find("\"traceEvents\"") != std::string::npos);
+        CHECK(json.find("\"ph\":\"X\"") != std::string::npos);
+
+        // Every pipeline stage is recorded and tied to the request it ran for
+        const char *stages[] = { "speak", "engine_wait", "synthesize", "inference", "pcm_convert", "wav_create", "file_write" };
+        for (const char *stage : stages) {
+            std::string name = std::string("\"name\":\"") + stage + "\"";
+            int spans = 0;
+            size_t line_start = 0;
+            while (line_start < json.size()) {
+                size_t line_end = json.find('\n', line_start);
+                if (line_end == std::string::npos) line_end = json.size();
+                std::string line = json.substr(line_start, line_end - line_start);
+                if (line.find(name) != std::string::npos) {
+                    spans++;
+                    CHECK(line.find("\"request_id\":0") == std::string::npos);
+                }
+                line_start = line_end + 1;
+            }
+            if (spans == 0) {
+                printf("     no %s span\n", stage);
+            }
+            CHECK(spans > 0);
+        }
+    }
+    tts.set_trace_enabled(false);
+    tts.clear_trace();
+}
+
+// Milliseconds from speak_streaming() to the first chunk and to stream_completed
+struct StreamTiming {
+    double first_chunk_msec = -1.0;
+    double total_msec = -1.0;
+};
+
+static StreamTiming time_stream(TextToSpeech &tts, const String &text, int timeout_msec) {
+    using Clock = std::chrono::steady_clock;
+    StreamTiming timing;
+    Clock::time_point start = Clock::now();
+    tts.speak_streaming(text);
+    while (timing.total_msec < 0.0) {
+        tts._process(0.001);
+        double elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        for (const SignalRecord &s : take_signals()) {
+            if (s.name == "chunk_ready" && timing.first_chunk_msec < 0.0) {
+                timing.first_chunk_msec = elapsed;
+            } else if (s.name == "stream_completed") {
+                timing.total_msec = elapsed;
+            }
+        }
+        if (elapsed > timeout_msec) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return timing;
+}
+
+// Benchmark: one long stream on a single engine and on four. The mock's
+// synthesis time is deterministic, so the speedup is the scheduler's alone.
+static void test_parallel_throughput() {
+    String text;
+    for (int i = 0; i < 8; i++) {
+        text += "This sentence is about one second long. ";
+    }
+
+    StreamTiming timings[2];
+    const int workers[2] = { 1, 4 };
+    for (int i = 0; i < 2; i++) {
+        TextToSpeech tts;
+        tts.set_parallel_workers(workers[i]);
+        tts.set_stream_lookahead(0);
+        load_mock(tts, 0.01f, 0.05f);
+        timings[i] = time_stream(tts, text, 5000);
+        CHECK(timings[i].total_msec > 0.0);
+        printf("     %d worker(s): first chunk %.0f ms, all 8 chunks %.0f ms\n",
+                workers[i], timings[i].first_chunk_msec, timings[i].total_msec);
+    }
+    CHECK(timings[1].total_msec < timings[0].total_msec * 0.6);
+}
+
+struct TestCase {
+    const char *name;
+    void (*run)();
+};
+
+static const TestCase TESTS[] = {
+    { "parallel_stream_order", test_parallel_stream_order },
+    { "coalescing", test_coalescing },
+    { "coalescing_disabled", test_coalescing_disabled },
+    { "fed_stream", test_fed_stream },
+    { "failed_last_chunk", test_failed_last_chunk },
+    { "failed_reload", test_failed_reload },
+    { "memory_usage", test_memory_usage },
+    { "stress", test_stress },
+    { "lookahead", test_lookahead },
+    { "render_to_file", test_render_to_file },
+    { "render_abandoned", test_render_abandoned },
+    { "adaptive_chunking", test_adaptive_chunking },
+    { "trace_export", test_trace_export },
+    { "parallel_throughput", test_parallel_throughput },
+};
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        output_dir = argv[1];
+    }
+
+    for (bool pool : { false, true }) {
+        use_pool = pool;
+        for (const TestCase &test : TESTS) {
+            int failures_before = failures;
+            test.run();
+            printf("%s %s%s\n", failures == failures_before ? "ok  " : "FAIL", test.name, pool ? " (pool)" : "");
+        }
+    }
+
+    printf("%d failure(s)\n", failures);
+    return failures == 0 ? 0 : 1;
+}